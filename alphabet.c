@@ -0,0 +1,185 @@
+/******************************************************************************
+* File Name:   alphabet.c
+*
+* Description: This file contains the password alphabet mapper. Each character
+* is drawn uniformly from the selected alphabet by rejection sampling on the
+* smallest number of random bits that covers the alphabet size. The bits are
+* taken from the bit reservoir, so unused bits serve the next character.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "alphabet.h"
+#include "bit_reservoir.h"
+#include "trng_stats.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static const alphabet_t alphabets[ALPHABET_COUNT] =
+{
+    [ALPHABET_PRINTABLE] =
+    {
+        .name  = "printable",
+        .first = ALPHABET_PRINTABLE_FIRST,
+        .steps = ALPHABET_PRINTABLE_STEPS,
+        .size  = ALPHABET_PRINTABLE_SIZE,
+        .bits  = ALPHABET_PRINTABLE_BITS,
+        .group = ALPHABET_PRINTABLE_GROUP,
+        .group_bits = ALPHABET_PRINTABLE_GROUP_BITS,
+        .group_size = ALPHABET_PRINTABLE_GROUP_SIZE,
+        .reciprocal = ALPHABET_RECIPROCAL(ALPHABET_PRINTABLE_SIZE,
+                                          ALPHABET_PRINTABLE_GROUP)
+    },
+    [ALPHABET_ALPHANUMERIC] =
+    {
+        .name  = "alphanumeric",
+        .first = ALPHABET_ALPHANUMERIC_FIRST,
+        .steps = ALPHABET_ALPHANUMERIC_STEPS,
+        .size  = ALPHABET_ALPHANUMERIC_SIZE,
+        .bits  = ALPHABET_ALPHANUMERIC_BITS,
+        .group = ALPHABET_ALPHANUMERIC_GROUP,
+        .group_bits = ALPHABET_ALPHANUMERIC_GROUP_BITS,
+        .group_size = ALPHABET_ALPHANUMERIC_GROUP_SIZE,
+        .reciprocal = ALPHABET_RECIPROCAL(ALPHABET_ALPHANUMERIC_SIZE,
+                                          ALPHABET_ALPHANUMERIC_GROUP)
+    },
+    [ALPHABET_BASE32] =
+    {
+        .name  = "base32",
+        .first = ALPHABET_BASE32_FIRST,
+        .steps = ALPHABET_BASE32_STEPS,
+        .size  = ALPHABET_BASE32_SIZE,
+        .bits  = ALPHABET_BASE32_BITS,
+        .group = ALPHABET_BASE32_GROUP,
+        .group_bits = ALPHABET_BASE32_GROUP_BITS,
+        .group_size = ALPHABET_BASE32_GROUP_SIZE,
+        .reciprocal = ALPHABET_RECIPROCAL(ALPHABET_BASE32_SIZE,
+                                          ALPHABET_BASE32_GROUP)
+    },
+    [ALPHABET_HEX] =
+    {
+        .name  = "hex",
+        .first = ALPHABET_HEX_FIRST,
+        .steps = ALPHABET_HEX_STEPS,
+        .size  = ALPHABET_HEX_SIZE,
+        .bits  = ALPHABET_HEX_BITS,
+        .group = ALPHABET_HEX_GROUP,
+        .group_bits = ALPHABET_HEX_GROUP_BITS,
+        .group_size = ALPHABET_HEX_GROUP_SIZE,
+        .reciprocal = ALPHABET_RECIPROCAL(ALPHABET_HEX_SIZE,
+                                          ALPHABET_HEX_GROUP)
+    }
+};
+
+/*******************************************************************************
+* Function Name: alphabet_get
+********************************************************************************
+* Summary:
+* This function returns the description of an alphabet.
+*
+* Parameters:
+*  id: Alphabet identifier
+*
+* Return:
+*  const alphabet_t *: NULL if id is not a valid alphabet
+*
+*******************************************************************************/
+const alphabet_t *alphabet_get(alphabet_id_t id)
+{
+    return (id < ALPHABET_COUNT) ? &alphabets[id] : NULL;
+}
+
+/*******************************************************************************
+* Function Name: alphabet_map
+********************************************************************************
+* Summary:
+* This function writes len characters drawn uniformly from the alphabet. A
+* candidate of alphabet->bits random bits is accepted when it is smaller than
+* the alphabet size and rejected otherwise, which keeps every character
+* equally likely. For power-of-two alphabets no candidate is ever rejected.
+* While at least alphabet->group characters are left, they are drawn
+* together from one candidate of alphabet->group_bits bits, accepted below
+* alphabet->group_size, which rejects fewer bits for the printable alphabet.
+* The comparison and the characters are computed without branches. Every
+* candidate is written to the next positions, which only advance when the
+* candidate is accepted, so only the number of rejections, not the accepted
+* characters, affects the run time.
+*
+* Parameters:
+*  alphabet: Alphabet to draw from
+*  out: Buffer for the characters
+*  len: Number of characters to write
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t alphabet_map(const alphabet_t *alphabet, uint8_t *out, size_t len)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t candidate;
+    uint32_t accepted;
+    uint32_t count;
+    size_t index = 0;
+
+    while ((index < len) && (result == CY_RSLT_SUCCESS))
+    {
+        /* The last characters that do not fill a group are drawn singly */
+        count = ((len - index) >= alphabet->group) ? alphabet->group : 1u;
+
+        result = bit_reservoir_take((count > 1u) ? alphabet->group_bits :
+                                    alphabet->bits, &candidate);
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            /* 1 if candidate < size to the power of count, 0 otherwise */
+            accepted = (candidate - ((count > 1u) ? alphabet->group_size :
+                                     alphabet->size)) >> 31;
+
+            alphabet_group_chars(alphabet->first, alphabet->steps,
+                                 alphabet->size, alphabet->reciprocal,
+                                 candidate, &out[index], count);
+            index += (accepted * count);
+
+            TRNG_STATS_ADD(alphabet_rejects, accepted ^ 1u);
+        }
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
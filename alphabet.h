@@ -0,0 +1,241 @@
+/******************************************************************************
+* File Name:   alphabet.h
+*
+* Description: This file contains the interface of the password alphabet mapper
+* for the HAL: MCU Cryptography: True Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ALPHABET_H
+#define ALPHABET_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Each alphabet is made of at most ALPHABET_MAX_STEPS + 1 runs of consecutive
+   ASCII codes. A character is computed from its index instead of being looked
+   up in a table, so neither a branch nor a memory access depends on it */
+#define ALPHABET_MAX_STEPS              (2u)
+
+/* Step that is never reached by an index */
+#define ALPHABET_STEP_NONE              { 0xFFu, 0 }
+
+/* A group of characters is drawn from one candidate, which is split into
+   digits with a multiplication by ALPHABET_RECIPROCAL(size, group) and a
+   shift instead of a division, whose run time depends on the operands. The
+   quotient is exact for a dividend below 2^24 and a size of 65 to 127 */
+#define ALPHABET_RECIPROCAL_SHIFT       (38u)
+#define ALPHABET_RECIPROCAL(size, group) \
+        (((group) > 1u) ? \
+         ((uint32_t)((1ull << ALPHABET_RECIPROCAL_SHIFT) / (size)) + 1u) : 0u)
+
+/* First character, steps between the runs, size and candidate bit count of
+   each alphabet, and the characters per group with the bit count and the
+   number of values of a group candidate. The names after ALPHABET_ are the
+   ones accepted by ALPHABET_ID() */
+
+/* '!' to '~' */
+#define ALPHABET_PRINTABLE_FIRST        ('!')
+#define ALPHABET_PRINTABLE_STEPS        { ALPHABET_STEP_NONE, \
+                                          ALPHABET_STEP_NONE }
+#define ALPHABET_PRINTABLE_SIZE         (94u)
+#define ALPHABET_PRINTABLE_BITS         (7u)
+
+/* 94^3 of 2^20: 3 characters for 20 bits with 79% acceptance, against 7 bits
+   with 73% acceptance for one */
+#define ALPHABET_PRINTABLE_GROUP        (3u)
+#define ALPHABET_PRINTABLE_GROUP_BITS   (20u)
+#define ALPHABET_PRINTABLE_GROUP_SIZE   (830584u)
+
+/* '0' to '9', 'A' to 'Z', 'a' to 'z' */
+#define ALPHABET_ALPHANUMERIC_FIRST     ('0')
+#define ALPHABET_ALPHANUMERIC_STEPS     { { 10u, 'A' - '9' - 1 }, \
+                                          { 36u, 'a' - 'Z' - 1 } }
+#define ALPHABET_ALPHANUMERIC_SIZE      (62u)
+#define ALPHABET_ALPHANUMERIC_BITS      (6u)
+#define ALPHABET_ALPHANUMERIC_GROUP     (1u)
+#define ALPHABET_ALPHANUMERIC_GROUP_BITS    ALPHABET_ALPHANUMERIC_BITS
+#define ALPHABET_ALPHANUMERIC_GROUP_SIZE    ALPHABET_ALPHANUMERIC_SIZE
+
+/* 'A' to 'Z', '2' to '7' */
+#define ALPHABET_BASE32_FIRST           ('A')
+#define ALPHABET_BASE32_STEPS           { { 26u, '2' - 'Z' - 1 }, \
+                                          ALPHABET_STEP_NONE }
+#define ALPHABET_BASE32_SIZE            (32u)
+#define ALPHABET_BASE32_BITS            (5u)
+#define ALPHABET_BASE32_GROUP           (1u)
+#define ALPHABET_BASE32_GROUP_BITS      ALPHABET_BASE32_BITS
+#define ALPHABET_BASE32_GROUP_SIZE      ALPHABET_BASE32_SIZE
+
+/* '0' to '9', 'a' to 'f' */
+#define ALPHABET_HEX_FIRST              ('0')
+#define ALPHABET_HEX_STEPS              { { 10u, 'a' - '9' - 1 }, \
+                                          ALPHABET_STEP_NONE }
+#define ALPHABET_HEX_SIZE               (16u)
+#define ALPHABET_HEX_BITS               (4u)
+#define ALPHABET_HEX_GROUP              (1u)
+#define ALPHABET_HEX_GROUP_BITS         ALPHABET_HEX_BITS
+#define ALPHABET_HEX_GROUP_SIZE         ALPHABET_HEX_SIZE
+
+/* alphabet_id_t of an alphabet name, e.g. ALPHABET_ID(HEX) */
+#define ALPHABET_ID(name)               ALPHABET_ID_(name)
+#define ALPHABET_ID_(name)              (ALPHABET_##name)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+/* Alphabets the password characters can be drawn from */
+typedef enum
+{
+    ALPHABET_PRINTABLE,     /* 94 visible ASCII characters '!' to '~' */
+    ALPHABET_ALPHANUMERIC,  /* 0-9, A-Z, a-z */
+    ALPHABET_BASE32,        /* RFC 4648 base32: A-Z, 2-7 */
+    ALPHABET_HEX,           /* 0-9, a-f */
+    ALPHABET_COUNT
+} alphabet_id_t;
+
+/* Start of a run of an alphabet: the characters from index on are delta
+   codes further than the run before would give */
+typedef struct
+{
+    uint8_t index;
+    int8_t delta;
+} alphabet_step_t;
+
+typedef struct
+{
+    const char *name;
+    char first;             /* Character of index 0 */
+    alphabet_step_t steps[ALPHABET_MAX_STEPS];
+    uint8_t size;           /* Number of characters */
+    uint8_t bits;           /* Smallest bit count that covers size */
+    uint8_t group;          /* Characters drawn from one group candidate */
+    uint8_t group_bits;     /* Bit count of a group candidate */
+    uint32_t group_size;    /* size to the power of group */
+    uint32_t reciprocal;    /* ALPHABET_RECIPROCAL(size, group) */
+} alphabet_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+const alphabet_t *alphabet_get(alphabet_id_t id);
+cy_rslt_t alphabet_map(const alphabet_t *alphabet, uint8_t *out, size_t len);
+
+/*******************************************************************************
+* Function Name: alphabet_char
+********************************************************************************
+* Summary:
+* This function returns the character of an index of an alphabet in constant
+* time. The steps are added under masks instead of branches, and no table is
+* indexed with the secret value.
+*
+* Parameters:
+*  first: Character of index 0
+*  steps: ALPHABET_MAX_STEPS steps of the alphabet
+*  index: Index, below 128
+*
+* Return:
+*  uint8_t
+*
+*******************************************************************************/
+__STATIC_FORCEINLINE uint8_t alphabet_char(char first,
+                                           const alphabet_step_t *steps,
+                                           uint32_t index)
+{
+    uint32_t value = (uint32_t)(uint8_t)first + index;
+    uint32_t mask;
+    uint32_t step;
+
+    for (step = 0; step < ALPHABET_MAX_STEPS; step++)
+    {
+        /* All ones if index >= steps[step].index, zero otherwise */
+        mask = ((index - steps[step].index) >> 31) - 1u;
+        value += (uint32_t)(int32_t)steps[step].delta & mask;
+    }
+
+    return (uint8_t)value;
+}
+
+/*******************************************************************************
+* Function Name: alphabet_group_chars
+********************************************************************************
+* Summary:
+* This function writes the characters of a candidate drawn for count
+* characters, the base size digits of the candidate, lowest first. The
+* digits are split off with multiplications, so the run time does not depend
+* on the candidate.
+*
+* Parameters:
+*  first: Character of index 0
+*  steps: ALPHABET_MAX_STEPS steps of the alphabet
+*  size: Number of characters
+*  reciprocal: ALPHABET_RECIPROCAL(size, count), not used for one character
+*  candidate: Candidate, below size to the power of count when accepted
+*  out: Buffer for count characters
+*  count: Number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_FORCEINLINE void alphabet_group_chars(char first,
+                                               const alphabet_step_t *steps,
+                                               uint32_t size,
+                                               uint32_t reciprocal,
+                                               uint32_t candidate,
+                                               uint8_t *out, uint32_t count)
+{
+    uint32_t quotient;
+    uint32_t digit;
+
+    for (digit = 0; digit < (count - 1u); digit++)
+    {
+        quotient = (uint32_t)(((uint64_t)candidate * reciprocal) >>
+                              ALPHABET_RECIPROCAL_SHIFT);
+        out[digit] = alphabet_char(first, steps,
+                                   candidate - (quotient * size));
+        candidate = quotient;
+    }
+
+    out[count - 1u] = alphabet_char(first, steps, candidate);
+}
+
+#endif /* ALPHABET_H */
+
+/* [] END OF FILE */
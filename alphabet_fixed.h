@@ -0,0 +1,157 @@
+/******************************************************************************
+* File Name:   alphabet_fixed.h
+*
+* Description: This file contains the password generators specialized at compile
+* time for one alphabet and one length. The alphabet size, the candidate bit
+* count, and the length are constants, so the candidate extraction compiles to
+* fixed shifts and masks, and the acceptance test disappears for power-of-two
+* alphabets.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ALPHABET_FIXED_H
+#define ALPHABET_FIXED_H
+
+#include "cyhal.h"
+#include "alphabet.h"
+#include "bit_reservoir.h"
+#include "trng_stats.h"
+#include "zeroize.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Defines "static cy_rslt_t function(uint8_t *out)", which writes length
+   characters of the alphabet ALPHABET_<name>, e.g.
+   ALPHABET_FIXED_GENERATOR(generate_hex_16, HEX, 16u) */
+#define ALPHABET_FIXED_GENERATOR(function, name, length) \
+        ALPHABET_FIXED_GENERATOR_(function, name, length)
+
+#define ALPHABET_FIXED_GENERATOR_(function, name, length) \
+    static cy_rslt_t function(uint8_t *out) \
+    { \
+        static const alphabet_step_t steps[ALPHABET_MAX_STEPS] = \
+            ALPHABET_##name##_STEPS; \
+        return alphabet_map_fixed(ALPHABET_##name##_FIRST, steps, \
+                                  ALPHABET_##name##_SIZE, \
+                                  ALPHABET_##name##_BITS, \
+                                  ALPHABET_##name##_GROUP, \
+                                  ALPHABET_##name##_GROUP_BITS, \
+                                  ALPHABET_##name##_GROUP_SIZE, \
+                                  ALPHABET_RECIPROCAL( \
+                                      ALPHABET_##name##_SIZE, \
+                                      ALPHABET_##name##_GROUP), \
+                                  out, (length)); \
+    }
+
+/*******************************************************************************
+* Function Name: alphabet_map_fixed
+********************************************************************************
+* Summary:
+* This function writes len characters drawn uniformly from an alphabet with
+* the same branch-free rejection sampling and character groups as
+* alphabet_map(). It is forced
+* inline, so it must only be called with constant arguments, as done by
+* ALPHABET_FIXED_GENERATOR(). The candidates are taken from the bit
+* reservoir, so the bits left over from a word are used by the next character
+* or the next consumer. The last candidate is wiped on return.
+*
+* Parameters:
+*  first: Character of index 0
+*  steps: ALPHABET_MAX_STEPS steps of the alphabet
+*  size: Number of characters
+*  bits: Smallest bit count that covers size
+*  group: Characters drawn from one group candidate
+*  group_bits: Bit count of a group candidate
+*  group_size: size to the power of group
+*  reciprocal: ALPHABET_RECIPROCAL(size, group)
+*  out: Buffer for the characters
+*  len: Number of characters to write
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+__STATIC_FORCEINLINE cy_rslt_t alphabet_map_fixed(char first,
+                                                  const alphabet_step_t *steps,
+                                                  uint32_t size, uint32_t bits,
+                                                  uint32_t group,
+                                                  uint32_t group_bits,
+                                                  uint32_t group_size,
+                                                  uint32_t reciprocal,
+                                                  uint8_t *out, size_t len)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t candidate = 0;
+    uint32_t accepted;
+    uint32_t count;
+    size_t index = 0;
+
+    while ((index < len) && (result == CY_RSLT_SUCCESS))
+    {
+        /* The last characters that do not fill a group are drawn singly */
+        count = ((len - index) >= group) ? group : 1u;
+
+        result = bit_reservoir_take((uint8_t)((count > 1u) ? group_bits :
+                                              bits), &candidate);
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            /* The constant mask lets the compiler drop the acceptance test
+               of a power-of-two alphabet */
+            candidate &= ((count > 1u) ? ((1u << group_bits) - 1u) :
+                          ((1u << bits) - 1u));
+
+            /* 1 if candidate < size to the power of count, 0 otherwise */
+            accepted = (candidate - ((count > 1u) ? group_size : size)) >> 31;
+
+            alphabet_group_chars(first, steps, size, reciprocal, candidate,
+                                 &out[index], count);
+            index += (accepted * count);
+
+            TRNG_STATS_ADD(alphabet_rejects, accepted ^ 1u);
+        }
+    }
+
+    zeroize(&candidate, sizeof(candidate));
+
+    return result;
+}
+
+#endif /* ALPHABET_FIXED_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,74 @@
+/******************************************************************************
+* File Name:   app_result.h
+*
+* Description: This file contains the result codes returned by the modules of
+* the HAL: MCU Cryptography: True Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef APP_RESULT_H
+#define APP_RESULT_H
+
+#include "cy_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Module identifier of the application result codes */
+#define APP_RSLT_MODULE                 (CY_RSLT_MODULE_MIDDLEWARE_BASE + 0xFFu)
+
+#define APP_RSLT_ERR(code)              (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, \
+                                         APP_RSLT_MODULE, (code)))
+
+/* Invalid argument */
+#define APP_RSLT_ERR_BAD_PARAM          (APP_RSLT_ERR(1u))
+
+/* Module used before it was initialized */
+#define APP_RSLT_ERR_NOT_READY          (APP_RSLT_ERR(2u))
+
+/* Crypto block operation failed */
+#define APP_RSLT_ERR_CRYPTO             (APP_RSLT_ERR(3u))
+
+/* TRNG output rejected by the continuous health tests */
+#define APP_RSLT_ERR_HEALTH_TEST        (APP_RSLT_ERR(4u))
+
+/* TRNG out of use while a fault is recovered */
+#define APP_RSLT_ERR_TRNG_RECOVERY      (APP_RSLT_ERR(5u))
+
+#endif /* APP_RESULT_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,330 @@
+/******************************************************************************
+* File Name:   benchmark.c
+*
+* Description: This file contains the TRNG benchmark. Every case is timed per
+* call with the DWT cycle counter and reported as median and 99th percentile
+* latency in CPU cycles, together with the throughput at the median.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "benchmark.h"
+#include "trng_session.h"
+#include "random_source.h"
+#include "trng_fill.h"
+#include "alphabet.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* OTP generated by the end-to-end case. The record ends with a carriage
+   return so that all passwords are written over one terminal line */
+#define BENCHMARK_OTP_LENGTH            (8u)
+#define BENCHMARK_OTP_PREFIX            "One-Time Password: "
+#define BENCHMARK_OTP_SIZE              (sizeof(BENCHMARK_OTP_PREFIX) - 1u + \
+                                         BENCHMARK_OTP_LENGTH + 1u)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+typedef enum
+{
+    BENCHMARK_SESSION_OPEN,     /* trng_hal_init() and the startup test */
+    BENCHMARK_RAW_WORD,         /* One health tested word, no pool */
+    BENCHMARK_TRNG_WORD,        /* One conditioned word from the pool */
+    BENCHMARK_TRNG_FILL,        /* trng_fill() from the TRNG source */
+    BENCHMARK_DRBG_FILL,        /* trng_fill() from the DRBG source */
+    BENCHMARK_OTP               /* Password generation and UART output */
+} benchmark_case_t;
+
+typedef struct
+{
+    const char *name;
+    uint32_t bytes;             /* Bytes produced by one call, 0 for none */
+} benchmark_info_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void run_case(benchmark_case_t bench_case);
+static cy_rslt_t run_call(benchmark_case_t bench_case);
+static void sort_samples(uint32_t count);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static const benchmark_info_t benchmark_info[] =
+{
+    [BENCHMARK_SESSION_OPEN] = { "TRNG session open",    0u                  },
+    [BENCHMARK_RAW_WORD]     = { "Raw TRNG word",        sizeof(uint32_t)    },
+    [BENCHMARK_TRNG_WORD]    = { "Conditioned word",     sizeof(uint32_t)    },
+    [BENCHMARK_TRNG_FILL]    = { "Bulk fill (TRNG)",     BENCHMARK_FILL_SIZE },
+    [BENCHMARK_DRBG_FILL]    = { "Bulk fill (DRBG)",     BENCHMARK_FILL_SIZE },
+    [BENCHMARK_OTP]          = { "OTP end-to-end",       BENCHMARK_OTP_LENGTH }
+};
+
+/* Cycle count of each measured call */
+static uint32_t samples[BENCHMARK_ITERATIONS];
+
+static uint8_t fill_buffer[BENCHMARK_FILL_SIZE];
+
+/*******************************************************************************
+* Function Name: benchmark_run
+********************************************************************************
+* Summary:
+* This function runs all benchmark cases and prints the results on the debug
+* UART. The random source selected before the call is restored at the end.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void benchmark_run(void)
+{
+    random_source_t source = random_source_get();
+    uint32_t bench_case;
+
+    /* Start the DWT cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    uart_tx_printf("\r\nBenchmark: %u calls per case, CPU clock %lu Hz\r\n",
+                   BENCHMARK_ITERATIONS, (unsigned long)SystemCoreClock);
+    uart_tx_printf("%-20s %12s %12s %12s\r\n", "Case", "Median cyc",
+                   "P99 cyc", "Bytes/s");
+
+    for (bench_case = 0; bench_case <= (uint32_t)BENCHMARK_OTP; bench_case++)
+    {
+        run_case((benchmark_case_t)bench_case);
+    }
+
+    (void)random_source_select(source);
+}
+
+/*******************************************************************************
+* Function Name: run_case
+********************************************************************************
+* Summary:
+* This function measures BENCHMARK_ITERATIONS calls of one case and prints
+* the result line.
+*
+* Parameters:
+*  bench_case: Case to measure
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run_case(benchmark_case_t bench_case)
+{
+    const benchmark_info_t *info = &benchmark_info[bench_case];
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t saved_intr_status = 0;
+    uint32_t start;
+    uint32_t median;
+    uint32_t count;
+    bool isolated;
+
+    /* Each case is measured with the UART idle */
+    uart_tx_flush();
+    uart_tx_wait();
+
+    (void)random_source_select((bench_case == BENCHMARK_DRBG_FILL) ?
+                               RANDOM_SOURCE_DRBG : RANDOM_SOURCE_TRNG);
+
+    /* The TRNG block itself is measured without the refill interrupt. The
+       other cases include it, as in normal operation */
+    isolated = (bench_case == BENCHMARK_SESSION_OPEN) ||
+               (bench_case == BENCHMARK_RAW_WORD);
+
+    for (count = 0; (count < BENCHMARK_ITERATIONS) &&
+                    (result == CY_RSLT_SUCCESS); count++)
+    {
+        if (bench_case == BENCHMARK_SESSION_OPEN)
+        {
+            trng_session_close();
+        }
+
+        if (isolated)
+        {
+            saved_intr_status = cyhal_system_critical_section_enter();
+        }
+
+        start = DWT->CYCCNT;
+        result = run_call(bench_case);
+        samples[count] = DWT->CYCCNT - start;
+
+        if (isolated)
+        {
+            cyhal_system_critical_section_exit(saved_intr_status);
+        }
+    }
+
+    if (bench_case == BENCHMARK_OTP)
+    {
+        uart_tx_wait();
+        uart_tx_puts("\r\n");
+    }
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        uart_tx_printf("%-20s failed\r\n", info->name);
+        return;
+    }
+
+    sort_samples(BENCHMARK_ITERATIONS);
+    median = samples[BENCHMARK_ITERATIONS / 2u];
+
+    uart_tx_printf("%-20s %12lu %12lu ", info->name, (unsigned long)median,
+                   (unsigned long)samples[(BENCHMARK_ITERATIONS * 99u) /
+                                          100u]);
+
+    if ((info->bytes != 0u) && (median != 0u))
+    {
+        uart_tx_printf("%12lu\r\n",
+                       (unsigned long)(((uint64_t)info->bytes *
+                                        SystemCoreClock) / median));
+    }
+    else
+    {
+        uart_tx_printf("%12s\r\n", "-");
+    }
+
+    /* Password rate at the median, the figure recorded per build profile */
+    if ((bench_case == BENCHMARK_OTP) && (median != 0u))
+    {
+        uart_tx_printf("%-20s %12lu\r\n", "OTPs per second",
+                       (unsigned long)(SystemCoreClock / median));
+    }
+}
+
+/*******************************************************************************
+* Function Name: run_call
+********************************************************************************
+* Summary:
+* This function performs one measured call of a case. The OTP case covers
+* the character mapping and the UART transfer of the record.
+*
+* Parameters:
+*  bench_case: Case to run
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t run_call(benchmark_case_t bench_case)
+{
+    cy_rslt_t result;
+    uint32_t word;
+    uint8_t *record;
+
+    switch (bench_case)
+    {
+        case BENCHMARK_SESSION_OPEN:
+            result = trng_session_open();
+            break;
+
+        case BENCHMARK_RAW_WORD:
+            result = trng_session_generate(&word);
+            break;
+
+        case BENCHMARK_TRNG_WORD:
+            result = random_source_word(&word);
+            break;
+
+        case BENCHMARK_OTP:
+            record = uart_tx_reserve(BENCHMARK_OTP_SIZE);
+            memcpy(record, BENCHMARK_OTP_PREFIX,
+                   sizeof(BENCHMARK_OTP_PREFIX) - 1u);
+            result = alphabet_map(alphabet_get(ALPHABET_PRINTABLE),
+                                  &record[sizeof(BENCHMARK_OTP_PREFIX) - 1u],
+                                  BENCHMARK_OTP_LENGTH);
+            if (result == CY_RSLT_SUCCESS)
+            {
+                record[BENCHMARK_OTP_SIZE - 1u] = '\r';
+                uart_tx_commit(BENCHMARK_OTP_SIZE);
+                uart_tx_flush();
+                uart_tx_wait();
+            }
+            break;
+
+        default:
+            result = trng_fill(fill_buffer, sizeof(fill_buffer));
+            break;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: sort_samples
+********************************************************************************
+* Summary:
+* This function sorts the cycle counts in ascending order.
+*
+* Parameters:
+*  count: Number of samples
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sort_samples(uint32_t count)
+{
+    uint32_t index;
+    uint32_t pos;
+    uint32_t value;
+
+    for (index = 1; index < count; index++)
+    {
+        value = samples[index];
+
+        for (pos = index; (pos > 0u) && (samples[pos - 1u] > value); pos--)
+        {
+            samples[pos] = samples[pos - 1u];
+        }
+
+        samples[pos] = value;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,144 @@
+/******************************************************************************
+* File Name:   bit_reservoir.c
+*
+* Description: This file contains the bit reservoir. Words from the random
+* source are appended to a 64-bit reservoir and consumers take exactly the
+* number of bits they need, so no random bit is thrown away between calls.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "bit_reservoir.h"
+#include "random_source.h"
+#include "zeroize.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define WORD_SIZE_BITS                  (32u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Random bits not yet consumed, lowest bit first */
+static uint64_t reservoir = 0;
+static uint8_t reservoir_bits = 0;
+
+/*******************************************************************************
+* Function Name: bit_reservoir_take
+********************************************************************************
+* Summary:
+* This function returns the requested number of random bits. A new word is
+* taken from the random source only when the reservoir holds fewer bits than
+* requested.
+*
+* Parameters:
+*  bits: Number of bits, 1 to BIT_RESERVOIR_MAX_BITS
+*  value: Location to store the bits, right aligned
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t bit_reservoir_take(uint8_t bits, uint32_t *value)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t random_val;
+
+    CY_ASSERT((bits > 0u) && (bits <= BIT_RESERVOIR_MAX_BITS));
+
+    if (reservoir_bits < bits)
+    {
+        result = random_source_password_word(&random_val);
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            reservoir |= ((uint64_t)random_val << reservoir_bits);
+            reservoir_bits += WORD_SIZE_BITS;
+        }
+
+        zeroize(&random_val, sizeof(random_val));
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        *value = (uint32_t)(reservoir & ((1ull << bits) - 1u));
+        reservoir >>= bits;
+        reservoir_bits -= bits;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: bit_reservoir_level
+********************************************************************************
+* Summary:
+* This function returns the number of random bits held by the reservoir.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint8_t
+*
+*******************************************************************************/
+uint8_t bit_reservoir_level(void)
+{
+    return reservoir_bits;
+}
+
+/*******************************************************************************
+* Function Name: bit_reservoir_flush
+********************************************************************************
+* Summary:
+* This function discards the buffered bits, for example after the random
+* source changed.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void bit_reservoir_flush(void)
+{
+    zeroize(&reservoir, sizeof(reservoir));
+    reservoir_bits = 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,290 @@
+/******************************************************************************
+* File Name:   command.c
+*
+* Description: This file contains the UART command parser. A command line is a
+* single command character optionally followed by an argument and is
+* terminated by a carriage return. An empty line requests password generation
+* with the current settings.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "command.h"
+#include "alphabet.h"
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static bool parse_number(const char *text, uint32_t *value);
+static bool parse_alphabet(const char *text, uint32_t *value);
+
+/*******************************************************************************
+* Function Name: command_parse
+********************************************************************************
+* Summary:
+* This function decodes a command line. The argument is only checked for its
+* syntax; range checks are left to the caller.
+*
+* Parameters:
+*  line: Received characters, without the carriage return
+*  length: Number of received characters, at most COMMAND_LINE_SIZE
+*  command: Decoded command. type is COMMAND_INVALID if the line is malformed
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void command_parse(const uint8_t *line, uint32_t length, command_t *command)
+{
+    char argument[COMMAND_LINE_SIZE];
+    bool valid = false;
+
+    command->type = COMMAND_INVALID;
+    command->value = 0;
+
+    if (length == 0u)
+    {
+        command->type = COMMAND_GENERATE;
+    }
+    else if (length <= COMMAND_LINE_SIZE)
+    {
+        memcpy(argument, &line[1], length - 1u);
+        argument[length - 1u] = '\0';
+
+        switch (line[0])
+        {
+            case COMMAND_CHAR_BATCH:
+                command->type = COMMAND_BATCH;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_LENGTH:
+                command->type = COMMAND_LENGTH;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_ALPHABET:
+                command->type = COMMAND_ALPHABET;
+                valid = parse_alphabet(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_COUNT:
+                command->type = COMMAND_COUNT;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_MODE:
+                command->type = COMMAND_MODE;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_EXPORT:
+                command->type = COMMAND_EXPORT;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_SOURCE:
+                command->type = COMMAND_SOURCE;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_RESEED:
+                command->type = COMMAND_RESEED;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_OSCILLATORS:
+                command->type = COMMAND_OSCILLATORS;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_SAMPLE_DIV:
+                command->type = COMMAND_SAMPLE_DIV;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_BIT_COUNT:
+                command->type = COMMAND_BIT_COUNT;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_LOW_POWER:
+                command->type = COMMAND_LOW_POWER;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_STREAM:
+                command->type = COMMAND_STREAM;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_CAPTURE:
+                command->type = COMMAND_CAPTURE;
+                valid = parse_number(argument, &command->value);
+                break;
+
+            case COMMAND_CHAR_ENROLL:
+                command->type = COMMAND_ENROLL;
+                valid = (length == 1u);
+                break;
+
+            case COMMAND_CHAR_HOTP:
+                command->type = COMMAND_HOTP;
+                valid = (length == 1u);
+                break;
+
+            case COMMAND_CHAR_TOTP:
+                if (length == 1u)
+                {
+                    command->type = COMMAND_TOTP;
+                    valid = true;
+                }
+                else
+                {
+                    command->type = COMMAND_TIME;
+                    valid = parse_number(argument, &command->value);
+                }
+                break;
+
+            case COMMAND_CHAR_STATS:
+                command->type = COMMAND_STATS;
+                valid = (length == 1u);
+                break;
+
+            case COMMAND_CHAR_SETTINGS:
+                command->type = COMMAND_SETTINGS;
+                valid = (length == 1u);
+                break;
+
+            default:
+                break;
+        }
+
+        if (!valid)
+        {
+            command->type = COMMAND_INVALID;
+        }
+    }
+    else
+    {
+        /* Line longer than any valid command */
+    }
+}
+
+/*******************************************************************************
+* Function Name: parse_number
+********************************************************************************
+* Summary:
+* This function converts a non-empty string of decimal digits. Numbers above
+* UINT32_MAX are rejected instead of wrapping around.
+*
+* Parameters:
+*  text: NULL terminated argument
+*  value: Converted number
+*
+* Return:
+*  bool: true if the whole argument is a number that fits into 32 bits
+*
+*******************************************************************************/
+static bool parse_number(const char *text, uint32_t *value)
+{
+    uint32_t number = 0;
+    uint32_t digit;
+
+    if (text[0] == '\0')
+    {
+        return false;
+    }
+
+    for (; *text != '\0'; text++)
+    {
+        if ((*text < '0') || (*text > '9'))
+        {
+            return false;
+        }
+
+        digit = (uint32_t)(*text - '0');
+
+        if (number > ((UINT32_MAX - digit) / 10u))
+        {
+            return false;
+        }
+
+        number = (number * 10u) + digit;
+    }
+
+    *value = number;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: parse_alphabet
+********************************************************************************
+* Summary:
+* This function converts an alphabet given by its index or its name.
+*
+* Parameters:
+*  text: NULL terminated argument
+*  value: alphabet_id_t of the alphabet
+*
+* Return:
+*  bool: true if the argument names a known alphabet
+*
+*******************************************************************************/
+static bool parse_alphabet(const char *text, uint32_t *value)
+{
+    uint32_t id;
+
+    if (parse_number(text, value))
+    {
+        return (*value < (uint32_t)ALPHABET_COUNT);
+    }
+
+    for (id = 0; id < (uint32_t)ALPHABET_COUNT; id++)
+    {
+        if (strcmp(text, alphabet_get((alphabet_id_t)id)->name) == 0)
+        {
+            *value = id;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* [] END OF FILE */
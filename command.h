@@ -0,0 +1,117 @@
+/******************************************************************************
+* File Name:   command.h
+*
+* Description: This file contains the interface of the UART command parser for
+* the HAL: MCU Cryptography: True Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef COMMAND_H
+#define COMMAND_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Longest command line accepted, excluding the carriage return */
+#define COMMAND_LINE_SIZE               (16u)
+
+/* Command prefixes */
+#define COMMAND_CHAR_BATCH              ('B')
+#define COMMAND_CHAR_LENGTH             ('L')
+#define COMMAND_CHAR_ALPHABET           ('A')
+#define COMMAND_CHAR_COUNT              ('C')
+#define COMMAND_CHAR_SETTINGS           ('?')
+#define COMMAND_CHAR_MODE               ('M')
+#define COMMAND_CHAR_EXPORT             ('X')
+#define COMMAND_CHAR_SOURCE             ('D')
+#define COMMAND_CHAR_RESEED             ('I')
+#define COMMAND_CHAR_OSCILLATORS        ('O')
+#define COMMAND_CHAR_SAMPLE_DIV         ('K')
+#define COMMAND_CHAR_BIT_COUNT          ('W')
+#define COMMAND_CHAR_STATS              ('S')
+#define COMMAND_CHAR_LOW_POWER          ('P')
+#define COMMAND_CHAR_STREAM             ('R')
+#define COMMAND_CHAR_CAPTURE            ('N')
+#define COMMAND_CHAR_ENROLL             ('E')
+#define COMMAND_CHAR_HOTP               ('H')
+#define COMMAND_CHAR_TOTP               ('T')
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+typedef enum
+{
+    COMMAND_GENERATE,       /* Empty line */
+    COMMAND_BATCH,          /* B<count> */
+    COMMAND_LENGTH,         /* L<length> */
+    COMMAND_ALPHABET,       /* A<index> or A<name> */
+    COMMAND_COUNT,          /* C<count> */
+    COMMAND_SETTINGS,       /* ? */
+    COMMAND_MODE,           /* M0 text mode, M1 binary mode */
+    COMMAND_EXPORT,         /* X<bytes> */
+    COMMAND_SOURCE,         /* D0 TRNG, D1 DRBG */
+    COMMAND_RESEED,         /* I<interval> */
+    COMMAND_OSCILLATORS,    /* O<mask>, O0 for the HAL defaults */
+    COMMAND_SAMPLE_DIV,     /* K<divider> */
+    COMMAND_BIT_COUNT,      /* W<bits> */
+    COMMAND_STATS,          /* S */
+    COMMAND_LOW_POWER,      /* P0 or P1 */
+    COMMAND_STREAM,         /* R<credits>, R0 stops the stream */
+    COMMAND_CAPTURE,        /* N<words> */
+    COMMAND_ENROLL,         /* E */
+    COMMAND_HOTP,           /* H */
+    COMMAND_TOTP,           /* T */
+    COMMAND_TIME,           /* T<unix time> */
+    COMMAND_INVALID
+} command_type_t;
+
+typedef struct
+{
+    command_type_t type;
+    uint32_t value;         /* Numeric argument or alphabet_id_t */
+} command_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void command_parse(const uint8_t *line, uint32_t length, command_t *command);
+
+#endif /* COMMAND_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,187 @@
+/******************************************************************************
+* File Name:   conditioner.c
+*
+* Description: This file contains the SHA-256 conditioner. Batches of
+* CONDITIONER_INPUT_WORDS raw words from the entropy pool are hashed on the
+* crypto block and the digest is handed out one 32-bit word at a time.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "conditioner.h"
+#include "crypto_block.h"
+#include "entropy_pool.h"
+#include "ipc_entropy.h"
+#include "trng_stats.h"
+#include "zeroize.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define CONDITIONER_DIGEST_WORDS        (32u / sizeof(uint32_t))
+
+/* Full entropy output needs 256 + 64 bits of input entropy (SP 800-90B
+   section 3.1.5.1.2). With the 0.5 bit per bit assumed by the health tests,
+   that is 20 words */
+#if (CONDITIONER_INPUT_WORDS < 20u)
+#error "CONDITIONER_INPUT_WORDS must be at least 20"
+#endif
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static CRYPTO_Type *crypto_base = NULL;
+
+/* Raw batch and the digest not handed out yet */
+static uint32_t input_words[CONDITIONER_INPUT_WORDS];
+static uint32_t digest_words[CONDITIONER_DIGEST_WORDS];
+static uint32_t digest_index = CONDITIONER_DIGEST_WORDS;
+
+/*******************************************************************************
+* Function Name: conditioner_init
+********************************************************************************
+* Summary:
+* This function gets the crypto block used for the SHA-256 operations.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t conditioner_init(void)
+{
+    return crypto_block_reserve(&crypto_base);
+}
+
+/*******************************************************************************
+* Function Name: conditioner_get
+********************************************************************************
+* Summary:
+* This function returns one conditioned 32-bit word. When the digest is used
+* up, the next CONDITIONER_INPUT_WORDS raw words are hashed into a new one.
+* The raw words come from the entropy pool, or from the CM0+ in dual-core
+* builds.
+*
+* Parameters:
+*  value: Location to store the word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t conditioner_get(uint32_t *value)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t saved_intr_status;
+    uint32_t index;
+
+    if (crypto_base == NULL)
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    if (digest_index >= CONDITIONER_DIGEST_WORDS)
+    {
+        for (index = 0; (index < CONDITIONER_INPUT_WORDS) &&
+                        (result == CY_RSLT_SUCCESS); index++)
+        {
+#if defined(ENTROPY_IPC_ENABLE)
+            /* The TRNG is owned by the CM0+ */
+            result = ipc_entropy_get(&input_words[index]);
+#else
+            result = entropy_pool_get(&input_words[index]);
+#endif
+        }
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            /* Keep the refill interrupt off the crypto block during SHA */
+            saved_intr_status = cyhal_system_critical_section_enter();
+            if (Cy_Crypto_Core_Sha(crypto_base, (const uint8_t *)input_words,
+                                   sizeof(input_words),
+                                   (uint8_t *)digest_words,
+                                   CY_CRYPTO_MODE_SHA256) != CY_CRYPTO_SUCCESS)
+            {
+                result = APP_RSLT_ERR_CRYPTO;
+            }
+            cyhal_system_critical_section_exit(saved_intr_status);
+        }
+
+        zeroize(input_words, sizeof(input_words));
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            TRNG_STATS_INC(digests);
+            digest_index = 0;
+        }
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        *value = digest_words[digest_index];
+
+        /* A word is never handed out twice */
+        digest_words[digest_index] = 0;
+        digest_index++;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: conditioner_flush
+********************************************************************************
+* Summary:
+* This function discards the rest of the current digest.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void conditioner_flush(void)
+{
+    zeroize(digest_words, sizeof(digest_words));
+    digest_index = CONDITIONER_DIGEST_WORDS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,131 @@
+/******************************************************************************
+* File Name:   crypto_block.c
+*
+* Description: This file contains the shared reservation of the crypto block.
+* The HAL allows the common crypto features to be reserved once, so all
+* modules using the AES and SHA engines get the block from here.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "cyhal_crypto_common.h"
+#include "crypto_block.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static CRYPTO_Type *crypto_base = NULL;
+static cyhal_resource_inst_t crypto_rsc;
+
+/*******************************************************************************
+* Function Name: crypto_block_reserve
+********************************************************************************
+* Summary:
+* This function returns the crypto block, reserving it on the first call. The
+* TRNG of the same block stays with cyhal_trng. Must be called from thread
+* context.
+*
+* Parameters:
+*  base: Location to store the base address of the crypto block
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t crypto_block_reserve(CRYPTO_Type **base)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (crypto_base == NULL)
+    {
+        result = cyhal_crypto_reserve(&crypto_base, &crypto_rsc,
+                                      CYHAL_CRYPTO_COMMON);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        *base = crypto_base;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: crypto_block_suspend
+********************************************************************************
+* Summary:
+* This function powers the crypto block off, for example before DeepSleep.
+* The TRNG session must be closed. All key material loaded into the block is
+* lost and must be loaded again after crypto_block_resume().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void crypto_block_suspend(void)
+{
+    if (crypto_base != NULL)
+    {
+        Cy_Crypto_Core_Disable(crypto_base);
+    }
+}
+
+/*******************************************************************************
+* Function Name: crypto_block_resume
+********************************************************************************
+* Summary:
+* This function powers the crypto block on again after crypto_block_suspend().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void crypto_block_resume(void)
+{
+    if (crypto_base != NULL)
+    {
+        Cy_Crypto_Core_Enable(crypto_base);
+    }
+}
+
+/* [] END OF FILE */
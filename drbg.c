@@ -0,0 +1,423 @@
+/******************************************************************************
+* File Name:   drbg.c
+*
+* Description: This file contains an SP 800-90A CTR_DRBG based on AES-256 without
+* a derivation function. The AES operations run on the crypto block and the
+* seed material is taken from the conditioned TRNG output at instantiation and on
+* every reseed.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_pdl.h"
+#include "drbg.h"
+#include "crypto_block.h"
+#include "conditioner.h"
+#include "zeroize.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define DRBG_BLOCK_SIZE                 (16u)
+#define DRBG_KEY_SIZE                   (32u)
+
+/* seedlen of CTR_DRBG with AES-256 */
+#define DRBG_SEED_SIZE                  (DRBG_KEY_SIZE + DRBG_BLOCK_SIZE)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static cy_rslt_t drbg_update(const uint8_t *provided_data);
+static cy_rslt_t drbg_encrypt_v(uint8_t *out);
+static cy_rslt_t drbg_get_seed(uint8_t *seed);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Internal state of the DRBG */
+static uint8_t drbg_key[DRBG_KEY_SIZE];
+static uint8_t drbg_v[DRBG_BLOCK_SIZE];
+static uint32_t reseed_counter = 0;
+static uint32_t reseed_interval = DRBG_DEFAULT_RESEED_INTERVAL;
+static bool instantiated = false;
+
+/* Crypto block used for the AES operations */
+static CRYPTO_Type *crypto_base;
+static cy_stc_crypto_aes_state_t aes_state;
+
+/* Working buffers of reseed, generate and update. They are static so that
+   the stack use of the generate path does not depend on the DRBG, and they
+   are wiped after every use */
+static uint8_t drbg_seed[DRBG_SEED_SIZE];
+static uint8_t drbg_temp[DRBG_SEED_SIZE];
+static uint8_t drbg_block[DRBG_BLOCK_SIZE];
+
+/*******************************************************************************
+* Function Name: drbg_init
+********************************************************************************
+* Summary:
+* This function reserves the crypto block and instantiates the DRBG with
+* DRBG_SEED_SIZE bytes of conditioned TRNG output.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t drbg_init(void)
+{
+    cy_rslt_t result;
+    uint32_t saved_intr_status;
+
+    result = crypto_block_reserve(&crypto_base);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        /* Key = 0, V = 0 before the first update */
+        memset(drbg_key, 0, sizeof(drbg_key));
+        memset(drbg_v, 0, sizeof(drbg_v));
+
+        saved_intr_status = cyhal_system_critical_section_enter();
+        if (Cy_Crypto_Core_Aes_Init(crypto_base, drbg_key,
+                                    CY_CRYPTO_KEY_AES_256, &aes_state)
+            != CY_CRYPTO_SUCCESS)
+        {
+            result = APP_RSLT_ERR_CRYPTO;
+        }
+        cyhal_system_critical_section_exit(saved_intr_status);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = drbg_reseed();
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: drbg_reseed
+********************************************************************************
+* Summary:
+* This function mixes fresh TRNG output into the DRBG state and restarts the
+* reseed counter.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t drbg_reseed(void)
+{
+    cy_rslt_t result;
+    uint32_t saved_intr_status;
+
+    result = drbg_get_seed(drbg_seed);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        /* Keep the refill interrupt off the crypto block during AES */
+        saved_intr_status = cyhal_system_critical_section_enter();
+        result = drbg_update(drbg_seed);
+        cyhal_system_critical_section_exit(saved_intr_status);
+    }
+
+    zeroize(drbg_seed, sizeof(drbg_seed));
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        reseed_counter = 1u;
+        instantiated = true;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: drbg_generate
+********************************************************************************
+* Summary:
+* This function produces pseudo-random bytes. The DRBG is reseeded first when
+* the reseed interval has been reached.
+*
+* Parameters:
+*  out: Buffer for the output
+*  length: Number of bytes, at most DRBG_MAX_REQUEST_BYTES
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t drbg_generate(uint8_t *out, uint32_t length)
+{
+    static const uint8_t no_additional_input[DRBG_SEED_SIZE] = {0};
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t saved_intr_status;
+    uint32_t chunk;
+
+    if (!instantiated)
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    if (length > DRBG_MAX_REQUEST_BYTES)
+    {
+        return APP_RSLT_ERR_BAD_PARAM;
+    }
+
+    if (reseed_counter > reseed_interval)
+    {
+        result = drbg_reseed();
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        /* Keep the refill interrupt off the crypto block during AES */
+        saved_intr_status = cyhal_system_critical_section_enter();
+
+        while ((length > 0u) && (result == CY_RSLT_SUCCESS))
+        {
+            result = drbg_encrypt_v(drbg_block);
+            chunk = (length > DRBG_BLOCK_SIZE) ? DRBG_BLOCK_SIZE : length;
+            memcpy(out, drbg_block, chunk);
+            out += chunk;
+            length -= chunk;
+        }
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            /* Backtracking resistance */
+            result = drbg_update(no_additional_input);
+        }
+
+        cyhal_system_critical_section_exit(saved_intr_status);
+
+        zeroize(drbg_block, sizeof(drbg_block));
+        reseed_counter++;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: drbg_set_reseed_interval
+********************************************************************************
+* Summary:
+* This function sets the number of generate requests between two reseeds.
+*
+* Parameters:
+*  interval: 1 to DRBG_MAX_RESEED_INTERVAL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void drbg_set_reseed_interval(uint32_t interval)
+{
+    if ((interval > 0u) && (interval <= DRBG_MAX_RESEED_INTERVAL))
+    {
+        reseed_interval = interval;
+    }
+}
+
+/*******************************************************************************
+* Function Name: drbg_get_reseed_interval
+********************************************************************************
+* Summary:
+* This function returns the number of generate requests between two reseeds.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t drbg_get_reseed_interval(void)
+{
+    return reseed_interval;
+}
+
+/*******************************************************************************
+* Function Name: drbg_reload_key
+********************************************************************************
+* Summary:
+* This function loads the current key into the AES engine again, after the
+* crypto block was powered off. The DRBG state itself is kept in SRAM.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t drbg_reload_key(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t saved_intr_status;
+
+    if (instantiated)
+    {
+        saved_intr_status = cyhal_system_critical_section_enter();
+        if (Cy_Crypto_Core_Aes_Init(crypto_base, drbg_key,
+                                    CY_CRYPTO_KEY_AES_256, &aes_state)
+            != CY_CRYPTO_SUCCESS)
+        {
+            result = APP_RSLT_ERR_CRYPTO;
+        }
+        cyhal_system_critical_section_exit(saved_intr_status);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: drbg_update
+********************************************************************************
+* Summary:
+* CTR_DRBG_Update. Derives a new key and V from the current state and
+* DRBG_SEED_SIZE bytes of provided data. Must be called with the crypto block
+* protected from the refill interrupt.
+*
+* Parameters:
+*  provided_data: DRBG_SEED_SIZE bytes
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t drbg_update(const uint8_t *provided_data)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t offset;
+
+    for (offset = 0; (offset < DRBG_SEED_SIZE) && (result == CY_RSLT_SUCCESS);
+         offset += DRBG_BLOCK_SIZE)
+    {
+        result = drbg_encrypt_v(&drbg_temp[offset]);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        for (offset = 0; offset < DRBG_SEED_SIZE; offset++)
+        {
+            drbg_temp[offset] ^= provided_data[offset];
+        }
+
+        memcpy(drbg_key, drbg_temp, DRBG_KEY_SIZE);
+        memcpy(drbg_v, &drbg_temp[DRBG_KEY_SIZE], DRBG_BLOCK_SIZE);
+
+        if (Cy_Crypto_Core_Aes_Init(crypto_base, drbg_key,
+                                    CY_CRYPTO_KEY_AES_256, &aes_state)
+            != CY_CRYPTO_SUCCESS)
+        {
+            result = APP_RSLT_ERR_CRYPTO;
+        }
+    }
+
+    zeroize(drbg_temp, sizeof(drbg_temp));
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: drbg_encrypt_v
+********************************************************************************
+* Summary:
+* This function increments V as a 128-bit big-endian counter and encrypts it
+* with the current key.
+*
+* Parameters:
+*  out: DRBG_BLOCK_SIZE bytes of output
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t drbg_encrypt_v(uint8_t *out)
+{
+    uint32_t index = DRBG_BLOCK_SIZE;
+
+    do
+    {
+        index--;
+        drbg_v[index]++;
+    } while ((drbg_v[index] == 0u) && (index > 0u));
+
+    return (Cy_Crypto_Core_Aes_Ecb(crypto_base, CY_CRYPTO_ENCRYPT, out, drbg_v,
+                                   &aes_state) == CY_CRYPTO_SUCCESS) ?
+           CY_RSLT_SUCCESS : APP_RSLT_ERR_CRYPTO;
+}
+
+/*******************************************************************************
+* Function Name: drbg_get_seed
+********************************************************************************
+* Summary:
+* This function takes DRBG_SEED_SIZE bytes of conditioned true random data.
+*
+* Parameters:
+*  seed: DRBG_SEED_SIZE bytes of output
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t drbg_get_seed(uint8_t *seed)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t random_val;
+    uint32_t offset;
+
+    for (offset = 0; (offset < DRBG_SEED_SIZE) && (result == CY_RSLT_SUCCESS);
+         offset += sizeof(random_val))
+    {
+        result = conditioner_get(&random_val);
+        memcpy(&seed[offset], &random_val, sizeof(random_val));
+    }
+
+    zeroize(&random_val, sizeof(random_val));
+
+    return result;
+}
+
+/* [] END OF FILE */
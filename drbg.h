@@ -0,0 +1,72 @@
+/******************************************************************************
+* File Name:   drbg.h
+*
+* Description: This file contains the interface of the AES-256 CTR_DRBG used by
+* the HAL: MCU Cryptography: True Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef DRBG_H
+#define DRBG_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Number of generate requests after which the DRBG is reseeded from the TRNG */
+#define DRBG_DEFAULT_RESEED_INTERVAL    (1024u)
+
+/* SP 800-90A limit for the reseed interval of CTR_DRBG */
+#define DRBG_MAX_RESEED_INTERVAL        (0x7FFFFFFFu)
+
+/* Largest output of a single generate request */
+#define DRBG_MAX_REQUEST_BYTES          (1024u)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t drbg_init(void);
+cy_rslt_t drbg_reseed(void);
+cy_rslt_t drbg_generate(uint8_t *out, uint32_t length);
+void drbg_set_reseed_interval(uint32_t interval);
+uint32_t drbg_get_reseed_interval(void);
+cy_rslt_t drbg_reload_key(void);
+
+#endif /* DRBG_H */
+
+/* [] END OF FILE */
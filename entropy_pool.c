@@ -0,0 +1,357 @@
+/******************************************************************************
+* File Name:   entropy_pool.c
+*
+* Description: This file contains the background entropy pool. A periodic timer
+* interrupt harvests words from the TRNG session into a single-producer,
+* single-consumer ring buffer, so that consumers read random numbers from RAM
+* instead of waiting for the TRNG hardware.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "entropy_pool.h"
+#include "trng_session.h"
+#include "trng_recovery.h"
+#include "health_test.h"
+#include "trng_stats.h"
+#include "zeroize.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define ENTROPY_POOL_INDEX_MASK         (ENTROPY_POOL_SIZE_WORDS - 1u)
+
+/* Refill timer clock and period */
+#define ENTROPY_POOL_TIMER_FREQ_HZ      (100000u)
+#define ENTROPY_POOL_TIMER_PERIOD       (ENTROPY_POOL_TIMER_FREQ_HZ / \
+                                         ENTROPY_POOL_REFILL_RATE_HZ)
+
+/* Interrupt priority of the refill timer */
+#define ENTROPY_POOL_TIMER_INTR_PRIORITY    (6u)
+
+#if ((ENTROPY_POOL_SIZE_WORDS & ENTROPY_POOL_INDEX_MASK) != 0u)
+#error "ENTROPY_POOL_SIZE_WORDS must be a power of two"
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void refill_timer_callback(void *callback_arg, cyhal_timer_event_t event);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Ring buffer of harvested TRNG words */
+static uint32_t pool_words[ENTROPY_POOL_SIZE_WORDS];
+
+/* Free-running indices. head is written only by the refill interrupt and tail
+   only by the consumer, so no lock is required between them */
+static volatile uint32_t pool_head = 0;
+static volatile uint32_t pool_tail = 0;
+
+/* Timer that periodically refills the pool */
+static cyhal_timer_t refill_timer_obj;
+
+/* Set once the refill timer runs */
+static bool pool_running = false;
+
+/*******************************************************************************
+* Function Name: entropy_pool_init
+********************************************************************************
+* Summary:
+* This function starts the periodic refill of the entropy pool. The TRNG
+* session must be initialized before calling it.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t entropy_pool_init(void)
+{
+    cy_rslt_t result;
+
+    const cyhal_timer_cfg_t refill_timer_cfg =
+    {
+        .compare_value = 0,
+        .period = ENTROPY_POOL_TIMER_PERIOD - 1u,
+        .direction = CYHAL_TIMER_DIR_UP,
+        .is_compare = false,
+        .is_continuous = true,
+        .value = 0
+    };
+
+    result = cyhal_timer_init(&refill_timer_obj, NC, NULL);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_configure(&refill_timer_obj, &refill_timer_cfg);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_set_frequency(&refill_timer_obj,
+                                           ENTROPY_POOL_TIMER_FREQ_HZ);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        cyhal_timer_register_callback(&refill_timer_obj, refill_timer_callback,
+                                      NULL);
+        cyhal_timer_enable_event(&refill_timer_obj,
+                                 CYHAL_TIMER_IRQ_TERMINAL_COUNT,
+                                 ENTROPY_POOL_TIMER_INTR_PRIORITY, true);
+
+        result = cyhal_timer_start(&refill_timer_obj);
+    }
+
+    pool_running = (result == CY_RSLT_SUCCESS);
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_get
+********************************************************************************
+* Summary:
+* This function returns one 32-bit random word from the pool. If the pool is
+* empty, the word is generated directly from the TRNG session. A word taken
+* from the pool never waits for the TRNG; the pool is topped up again by
+* entropy_pool_process(). While a TRNG fault is recovered, an empty pool fails
+* at once with APP_RSLT_ERR_TRNG_RECOVERY instead of waiting for the hardware.
+* Must be called from thread context by a single consumer.
+*
+* Parameters:
+*  value: Location to store the random word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t entropy_pool_get(uint32_t *value)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t saved_intr_status;
+    uint32_t tail = pool_tail;
+
+    if (pool_head != tail)
+    {
+        /* Make sure the word is read after the head index that published it */
+        __DMB();
+        *value = pool_words[tail & ENTROPY_POOL_INDEX_MASK];
+        __DMB();
+        pool_tail = tail + 1u;
+    }
+    else if (trng_recovery_is_active())
+    {
+        result = APP_RSLT_ERR_TRNG_RECOVERY;
+    }
+    else
+    {
+        /* Pool drained, wait for the hardware. The refill interrupt is held
+           off so it does not use the TRNG block at the same time */
+        TRNG_STATS_INC(pool_misses);
+        result = trng_session_open();
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            saved_intr_status = cyhal_system_critical_section_enter();
+            result = trng_session_generate(value);
+            cyhal_system_critical_section_exit(saved_intr_status);
+        }
+
+        if (result != CY_RSLT_SUCCESS)
+        {
+            trng_recovery_start();
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_available
+********************************************************************************
+* Summary:
+* This function returns the number of words currently held by the pool.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t entropy_pool_available(void)
+{
+    return (pool_head - pool_tail);
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_flush
+********************************************************************************
+* Summary:
+* This function discards all words held by the pool, for example after the
+* TRNG configuration changed, and wipes them together with the words already
+* taken. The refill interrupt is held off during the wipe. Must be called by
+* the consumer.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void entropy_pool_flush(void)
+{
+    uint32_t saved_intr_status;
+
+    saved_intr_status = cyhal_system_critical_section_enter();
+    zeroize(pool_words, sizeof(pool_words));
+    pool_tail = pool_head;
+    cyhal_system_critical_section_exit(saved_intr_status);
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_is_full
+********************************************************************************
+* Summary:
+* This function returns whether the pool holds ENTROPY_POOL_SIZE_WORDS words.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool entropy_pool_is_full(void)
+{
+    return ((pool_head - pool_tail) >= ENTROPY_POOL_SIZE_WORDS);
+}
+
+/*******************************************************************************
+* Function Name: entropy_pool_process
+********************************************************************************
+* Summary:
+* This function reopens a closed TRNG session when the pool is not full, so
+* that the refill interrupt tops it up again. A failed open, or a health test
+* failure detected by the refill interrupt, starts the fault recovery. It is
+* called from the main loop after the consumer has taken its words.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t entropy_pool_process(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (!pool_running || trng_recovery_is_active())
+    {
+        return result;
+    }
+
+    if (health_test_get_status() != HEALTH_TEST_OK)
+    {
+        result = APP_RSLT_ERR_HEALTH_TEST;
+    }
+    else if (!entropy_pool_is_full() && !trng_session_is_open())
+    {
+        result = trng_session_open();
+    }
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        trng_recovery_start();
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: refill_timer_callback
+********************************************************************************
+* Summary:
+* Refill timer terminal count handler. Harvests up to ENTROPY_POOL_REFILL_BURST
+* words into the pool while the TRNG session is open and the pool is not full.
+*
+* Parameters:
+*  callback_arg: Not used
+*  event: Timer event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void refill_timer_callback(void *callback_arg, cyhal_timer_event_t event)
+{
+    uint32_t head = pool_head;
+    uint32_t count;
+
+    CY_UNUSED_PARAMETER(callback_arg);
+    CY_UNUSED_PARAMETER(event);
+
+    for (count = 0; count < ENTROPY_POOL_REFILL_BURST; count++)
+    {
+        if (((head - pool_tail) >= ENTROPY_POOL_SIZE_WORDS) ||
+            !trng_session_is_open())
+        {
+            break;
+        }
+
+        if (trng_session_generate(&pool_words[head & ENTROPY_POOL_INDEX_MASK])
+            != CY_RSLT_SUCCESS)
+        {
+            break;
+        }
+
+        head++;
+    }
+
+    /* Publish the new words only after they are stored */
+    __DMB();
+    pool_head = head;
+}
+
+/* [] END OF FILE */
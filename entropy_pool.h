@@ -0,0 +1,73 @@
+/******************************************************************************
+* File Name:   entropy_pool.h
+*
+* Description: This file contains the interface of the background entropy pool
+* that buffers pre-harvested TRNG words for the HAL: MCU Cryptography: True
+* Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ENTROPY_POOL_H
+#define ENTROPY_POOL_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Number of 32-bit words held by the pool. Must be a power of two */
+#define ENTROPY_POOL_SIZE_WORDS         (64u)
+
+/* Rate at which the refill interrupt runs */
+#define ENTROPY_POOL_REFILL_RATE_HZ     (1000u)
+
+/* Maximum number of words harvested by a single refill interrupt */
+#define ENTROPY_POOL_REFILL_BURST       (4u)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t entropy_pool_init(void);
+cy_rslt_t entropy_pool_get(uint32_t *value);
+uint32_t entropy_pool_available(void);
+void entropy_pool_flush(void);
+bool entropy_pool_is_full(void);
+cy_rslt_t entropy_pool_process(void);
+
+#endif /* ENTROPY_POOL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,275 @@
+/******************************************************************************
+* File Name:   entropy_service.c
+*
+* Description: This file contains the FreeRTOS entropy service. A dedicated
+* harvester task is the only task that uses the TRNG session, the entropy
+* pool and the random source. Client tasks post requests to a queue and
+* block until the harvester has served them.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "entropy_service.h"
+
+#if defined(COMPONENT_FREERTOS)
+
+#include "task.h"
+#include "queue.h"
+#include "trng_session.h"
+#include "trng_fill.h"
+#include "entropy_pool.h"
+#include "trng_recovery.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+/* Request posted by a client. It lives on the stack of the client, which
+   blocks until the harvester notifies it */
+typedef struct
+{
+    entropy_service_job_t job;  /* NULL for a byte request */
+    void *arg;
+    uint8_t *buf;
+    size_t len;
+    TaskHandle_t client;
+    cy_rslt_t result;
+} entropy_request_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static cy_rslt_t submit(entropy_request_t *request,
+                        entropy_priority_t priority);
+static void harvester_task(void *arg);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Queue of entropy_request_t pointers */
+static QueueHandle_t request_queue = NULL;
+
+/*******************************************************************************
+* Function Name: entropy_service_init
+********************************************************************************
+* Summary:
+* This function creates the request queue and the harvester task. The TRNG
+* session and the random source must be initialized before, and no other
+* task may use them afterwards.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t entropy_service_init(void)
+{
+    request_queue = xQueueCreate(ENTROPY_SERVICE_QUEUE_LENGTH,
+                                 sizeof(entropy_request_t *));
+
+    if (request_queue == NULL)
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    if (xTaskCreate(harvester_task, "entropy", ENTROPY_SERVICE_STACK_SIZE,
+                    NULL, ENTROPY_SERVICE_TASK_PRIORITY, NULL) != pdPASS)
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: entropy_service_get
+********************************************************************************
+* Summary:
+* This function fills a buffer with random bytes from the selected random
+* source. The calling task blocks until the request is served.
+*
+* Parameters:
+*  buf: Buffer to fill
+*  len: Number of bytes
+*  priority: Queue position of the request
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t entropy_service_get(uint8_t *buf, size_t len,
+                              entropy_priority_t priority)
+{
+    entropy_request_t request =
+    {
+        .job = NULL,
+        .arg = NULL,
+        .buf = buf,
+        .len = len
+    };
+
+    return submit(&request, priority);
+}
+
+/*******************************************************************************
+* Function Name: entropy_service_call
+********************************************************************************
+* Summary:
+* This function runs a job in the harvester task, for work that uses the
+* random stack directly, such as password generation or configuration
+* changes. The calling task blocks until the job returns. Other requests are
+* served only after the job, so jobs should be short.
+*
+* Parameters:
+*  job: Function to run
+*  arg: Argument of the function
+*  priority: Queue position of the request
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t entropy_service_call(entropy_service_job_t job, void *arg,
+                               entropy_priority_t priority)
+{
+    entropy_request_t request =
+    {
+        .job = job,
+        .arg = arg,
+        .buf = NULL,
+        .len = 0u
+    };
+
+    if (job == NULL)
+    {
+        return APP_RSLT_ERR_BAD_PARAM;
+    }
+
+    return submit(&request, priority);
+}
+
+/*******************************************************************************
+* Function Name: submit
+********************************************************************************
+* Summary:
+* This function posts a request and waits for the harvester to complete it.
+* The wait is not bounded because the harvester writes into the request and
+* the client buffer until it notifies the client.
+*
+* Parameters:
+*  request: Request on the stack of the calling task
+*  priority: Queue position of the request
+*
+* Return:
+*  cy_rslt_t: Result of the request
+*
+*******************************************************************************/
+static cy_rslt_t submit(entropy_request_t *request,
+                        entropy_priority_t priority)
+{
+    BaseType_t queued;
+
+    if (request_queue == NULL)
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    request->client = xTaskGetCurrentTaskHandle();
+    request->result = CY_RSLT_SUCCESS;
+
+    queued = (priority == ENTROPY_PRIORITY_HIGH) ?
+             xQueueSendToFront(request_queue, &request, portMAX_DELAY) :
+             xQueueSendToBack(request_queue, &request, portMAX_DELAY);
+
+    if (queued != pdPASS)
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    return request->result;
+}
+
+/*******************************************************************************
+* Function Name: harvester_task
+********************************************************************************
+* Summary:
+* Harvester task. Serves the requests one at a time and powers the TRNG
+* block down once the session has been idle long enough. The session is
+* reopened when the entropy pool needs to be topped up.
+*
+* Parameters:
+*  arg: Not used
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void harvester_task(void *arg)
+{
+    entropy_request_t *request;
+
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        if (xQueueReceive(request_queue, &request,
+                          pdMS_TO_TICKS(ENTROPY_SERVICE_PROCESS_MS)) == pdTRUE)
+        {
+            if (request->job != NULL)
+            {
+                request->job(request->arg);
+            }
+            else
+            {
+                request->result = trng_fill(request->buf, request->len);
+            }
+
+            (void)xTaskNotifyGive(request->client);
+        }
+
+        trng_session_process();
+        trng_recovery_process();
+        (void)entropy_pool_process();
+    }
+}
+
+#endif /* COMPONENT_FREERTOS */
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/******************************************************************************
+* File Name:   entropy_service.h
+*
+* Description: This file contains the interface of the FreeRTOS entropy
+* service of the HAL: MCU Cryptography: True Random Number Generation
+* Example. It is available when the FREERTOS component is enabled.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef ENTROPY_SERVICE_H
+#define ENTROPY_SERVICE_H
+
+#include "cyhal.h"
+
+#if defined(COMPONENT_FREERTOS)
+
+#include "FreeRTOS.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Harvester task. It runs above all client tasks */
+#define ENTROPY_SERVICE_TASK_PRIORITY   (configMAX_PRIORITIES - 2u)
+#define ENTROPY_SERVICE_STACK_SIZE      (1024u)
+
+/* Requests that can be waiting for the harvester */
+#define ENTROPY_SERVICE_QUEUE_LENGTH    (8u)
+
+/* Longest wait of the harvester for a request before it runs the TRNG
+   session housekeeping */
+#define ENTROPY_SERVICE_PROCESS_MS      (100u)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+typedef enum
+{
+    ENTROPY_PRIORITY_NORMAL,    /* Served in order of arrival */
+    ENTROPY_PRIORITY_HIGH       /* Served before all waiting normal requests */
+} entropy_priority_t;
+
+/* Work run by the harvester task on behalf of a client */
+typedef void (*entropy_service_job_t)(void *arg);
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t entropy_service_init(void);
+cy_rslt_t entropy_service_get(uint8_t *buf, size_t len,
+                              entropy_priority_t priority);
+cy_rslt_t entropy_service_call(entropy_service_job_t job, void *arg,
+                               entropy_priority_t priority);
+
+#endif /* COMPONENT_FREERTOS */
+
+#endif /* ENTROPY_SERVICE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,210 @@
+/******************************************************************************
+* File Name:   frame.c
+*
+* Description: This file contains the binary frame encoder. Frames are built in
+* place in the UART transmit buffer: the caller writes the payload to the
+* location returned by frame_begin() and frame_end() appends the CRC and queues
+* the frame.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "frame.h"
+#include "uart_tx.h"
+#include "zeroize.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Reflected CRC-32 (IEEE 802.3) polynomial */
+#define FRAME_CRC32_INIT                (0xFFFFFFFFu)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* CRC-32 of every value of a nibble, for a 4-bit table driven update */
+static const uint32_t crc32_nibble_table[16] =
+{
+    0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+    0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+    0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+    0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+};
+
+/* Frame being built */
+static uint8_t *current_frame = NULL;
+static uint16_t current_length = 0;
+
+/*******************************************************************************
+* Function Name: frame_begin
+********************************************************************************
+* Summary:
+* This function reserves a frame in the UART transmit buffer and writes its
+* header.
+*
+* Parameters:
+*  type: Frame type
+*  length: Payload length, at most FRAME_MAX_PAYLOAD
+*
+* Return:
+*  uint8_t *: Location of the payload, NULL if length is too large
+*
+*******************************************************************************/
+uint8_t *frame_begin(uint8_t type, uint16_t length)
+{
+    if (length > FRAME_MAX_PAYLOAD)
+    {
+        return NULL;
+    }
+
+    current_frame = uart_tx_reserve(length + FRAME_OVERHEAD);
+    current_length = length;
+
+    current_frame[0] = FRAME_SYNC;
+    current_frame[1] = type;
+    current_frame[2] = (uint8_t)length;
+    current_frame[3] = (uint8_t)(length >> 8u);
+
+    return &current_frame[FRAME_HEADER_SIZE];
+}
+
+/*******************************************************************************
+* Function Name: frame_end
+********************************************************************************
+* Summary:
+* This function appends the CRC to the frame started by frame_begin() and
+* queues it for transmission.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void frame_end(void)
+{
+    uint32_t crc;
+    uint8_t *crc_field;
+
+    crc = frame_crc32(FRAME_CRC32_INIT, &current_frame[1],
+                      FRAME_HEADER_SIZE - 1u + current_length) ^
+          FRAME_CRC32_INIT;
+
+    crc_field = &current_frame[FRAME_HEADER_SIZE + current_length];
+    crc_field[0] = (uint8_t)crc;
+    crc_field[1] = (uint8_t)(crc >> 8u);
+    crc_field[2] = (uint8_t)(crc >> 16u);
+    crc_field[3] = (uint8_t)(crc >> 24u);
+
+    uart_tx_commit(current_length + FRAME_OVERHEAD);
+    current_frame = NULL;
+}
+
+/*******************************************************************************
+* Function Name: frame_abort
+********************************************************************************
+* Summary:
+* This function drops the frame started by frame_begin() without queuing it.
+* The payload written so far is wiped from the transmit buffer.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void frame_abort(void)
+{
+    if (current_frame != NULL)
+    {
+        zeroize(current_frame, current_length + FRAME_OVERHEAD);
+        current_frame = NULL;
+    }
+}
+
+/*******************************************************************************
+* Function Name: frame_write_status
+********************************************************************************
+* Summary:
+* This function queues a status frame with a single status byte.
+*
+* Parameters:
+*  status: One of the FRAME_STATUS_* values
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void frame_write_status(uint8_t status)
+{
+    uint8_t *payload = frame_begin(FRAME_TYPE_STATUS, 1u);
+
+    payload[0] = status;
+    frame_end();
+}
+
+/*******************************************************************************
+* Function Name: frame_crc32
+********************************************************************************
+* Summary:
+* This function updates a reflected CRC-32 over a block of data, one nibble
+* at a time.
+*
+* Parameters:
+*  crc: CRC of the preceding data, FRAME_CRC32_INIT for the first block
+*  data: Data to add
+*  length: Number of bytes
+*
+* Return:
+*  uint32_t: Updated CRC, to be inverted after the last block
+*
+*******************************************************************************/
+uint32_t frame_crc32(uint32_t crc, const uint8_t *data, uint32_t length)
+{
+    while (length > 0u)
+    {
+        crc ^= *data++;
+        crc = (crc >> 4u) ^ crc32_nibble_table[crc & 0x0Fu];
+        crc = (crc >> 4u) ^ crc32_nibble_table[crc & 0x0Fu];
+        length--;
+    }
+
+    return crc;
+}
+
+/* [] END OF FILE */
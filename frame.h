@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name:   frame.h
+*
+* Description: This file contains the interface of the binary frame encoder used
+* for bulk random export by the HAL: MCU Cryptography: True Random Number
+* Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Frame layout: sync, type, payload length (LE16), payload, CRC-32 (LE32).
+   The CRC covers the type, length and payload bytes */
+#define FRAME_SYNC                      (0xA5u)
+#define FRAME_HEADER_SIZE               (4u)
+#define FRAME_CRC_SIZE                  (4u)
+#define FRAME_OVERHEAD                  (FRAME_HEADER_SIZE + FRAME_CRC_SIZE)
+
+/* Largest payload carried by one frame */
+#define FRAME_MAX_PAYLOAD               (256u)
+
+/* Frame types */
+#define FRAME_TYPE_RANDOM               (0x01u)
+#define FRAME_TYPE_STATUS               (0x02u)
+#define FRAME_TYPE_RAW                  (0x03u)
+
+/* Payload of a status frame */
+#define FRAME_STATUS_OK                 (0x00u)
+#define FRAME_STATUS_ERROR              (0x01u)
+#define FRAME_STATUS_UNSUPPORTED        (0x02u)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+uint8_t *frame_begin(uint8_t type, uint16_t length);
+void frame_end(void);
+void frame_abort(void);
+void frame_write_status(uint8_t status);
+uint32_t frame_crc32(uint32_t crc, const uint8_t *data, uint32_t length);
+
+#endif /* FRAME_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,261 @@
+/******************************************************************************
+* File Name:   health_test.c
+*
+* Description: This file contains the SP 800-90B repetition count and adaptive
+* proportion tests. The noise source output is tested as a stream of bits,
+* LSB first, and every 32-bit word is processed in constant time.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "health_test.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Bits per tested word */
+#define HEALTH_TEST_WORD_BITS           (32u)
+
+/* The cutoffs assume a min-entropy of 0.5 bit per noise bit and a false
+   positive probability of 2^-20 per test, as in SP 800-90B section 4.4 */
+
+/* Repetition count test: 1 + ceil(20 / 0.5) identical bits in a row */
+#define HEALTH_TEST_RCT_CUTOFF          (41u)
+
+/* Adaptive proportion test: 1 + CRITBINOM(1024, 2^-0.5, 1 - 2^-20) bits of
+   a 1024 bit window equal to the first bit of the window */
+#define HEALTH_TEST_APT_CUTOFF          (793u)
+#define HEALTH_TEST_APT_WINDOW_WORDS    (1024u / HEALTH_TEST_WORD_BITS)
+
+/* A run inside one word can never reach the cutoff, so only the runs at
+   the word boundaries need to be tracked */
+#if (HEALTH_TEST_RCT_CUTOFF <= HEALTH_TEST_WORD_BITS)
+#error "HEALTH_TEST_RCT_CUTOFF must be larger than a word"
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static uint32_t count_ones(uint32_t word);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Repetition count test: value and length of the run ending the last word */
+static uint32_t rct_bit = 0;
+static uint32_t rct_run = 0;
+
+/* Adaptive proportion test: first bit of the window, matches so far and
+   words of the window processed */
+static uint32_t apt_bit = 0;
+static uint32_t apt_count = 0;
+static uint32_t apt_words = 0;
+
+/* Latched until health_test_clear() */
+static volatile health_test_status_t test_status = HEALTH_TEST_OK;
+
+/*******************************************************************************
+* Function Name: health_test_start
+********************************************************************************
+* Summary:
+* This function restarts both tests for a new run of the noise source. A
+* latched failure is kept.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void health_test_start(void)
+{
+    rct_bit = 0;
+    rct_run = 0;
+    apt_words = 0;
+}
+
+/*******************************************************************************
+* Function Name: health_test_feed
+********************************************************************************
+* Summary:
+* This function runs both tests on the 32 bits of one TRNG word. Must not be
+* called from thread context and an interrupt at the same time.
+*
+* Parameters:
+*  word: Raw TRNG output
+*
+* Return:
+*  bool: false if the word failed a test or a failure is latched
+*
+*******************************************************************************/
+bool health_test_feed(uint32_t word)
+{
+    uint32_t lead;
+    uint32_t last;
+    uint32_t ones = count_ones(word);
+
+    /* Repetition count test. With the word inverted when the current run
+       is of ones, the run continues over the trailing zero bits */
+    lead = __CLZ(__RBIT((rct_bit != 0u) ? ~word : word));
+    rct_run += lead;
+
+    /* Only the first failure is latched, so the reported cause is the one
+       that stopped the output */
+    if ((rct_run >= HEALTH_TEST_RCT_CUTOFF) &&
+        (test_status == HEALTH_TEST_OK))
+    {
+        test_status = HEALTH_TEST_RCT_FAILURE;
+    }
+
+    if (lead < HEALTH_TEST_WORD_BITS)
+    {
+        /* The run is broken inside the word, a new one ends the word */
+        last = word >> (HEALTH_TEST_WORD_BITS - 1u);
+        rct_bit = last;
+        rct_run = __CLZ((last != 0u) ? ~word : word);
+    }
+
+    /* Adaptive proportion test */
+    if (apt_words == 0u)
+    {
+        apt_bit = word & 1u;
+        apt_count = 0;
+    }
+
+    apt_count += (apt_bit != 0u) ? ones : (HEALTH_TEST_WORD_BITS - ones);
+    apt_words++;
+
+    if ((apt_count >= HEALTH_TEST_APT_CUTOFF) &&
+        (test_status == HEALTH_TEST_OK))
+    {
+        test_status = HEALTH_TEST_APT_FAILURE;
+    }
+
+    if (apt_words == HEALTH_TEST_APT_WINDOW_WORDS)
+    {
+        apt_words = 0;
+    }
+
+    return (test_status == HEALTH_TEST_OK);
+}
+
+/*******************************************************************************
+* Function Name: health_test_get_status
+********************************************************************************
+* Summary:
+* This function returns the first failure detected since the last clear.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  health_test_status_t
+*
+*******************************************************************************/
+health_test_status_t health_test_get_status(void)
+{
+    return test_status;
+}
+
+/*******************************************************************************
+* Function Name: health_test_status_name
+********************************************************************************
+* Summary:
+* This function returns a printable name of a health test status.
+*
+* Parameters:
+*  status: Status to name
+*
+* Return:
+*  const char *
+*
+*******************************************************************************/
+const char *health_test_status_name(health_test_status_t status)
+{
+    static const char *const names[] =
+    {
+        [HEALTH_TEST_OK] = "passed",
+        [HEALTH_TEST_RCT_FAILURE] = "repetition count",
+        [HEALTH_TEST_APT_FAILURE] = "adaptive proportion"
+    };
+
+    return ((uint32_t)status < (sizeof(names) / sizeof(names[0]))) ?
+           names[status] : "unknown";
+}
+
+/*******************************************************************************
+* Function Name: health_test_clear
+********************************************************************************
+* Summary:
+* This function clears a latched failure and restarts both tests.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void health_test_clear(void)
+{
+    health_test_start();
+    test_status = HEALTH_TEST_OK;
+}
+
+/*******************************************************************************
+* Function Name: count_ones
+********************************************************************************
+* Summary:
+* This function returns the number of set bits of a word.
+*
+* Parameters:
+*  word: Word to count
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+static uint32_t count_ones(uint32_t word)
+{
+    word = word - ((word >> 1) & 0x55555555u);
+    word = (word & 0x33333333u) + ((word >> 2) & 0x33333333u);
+    word = (word + (word >> 4)) & 0x0F0F0F0Fu;
+
+    return (word * 0x01010101u) >> 24;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,77 @@
+/******************************************************************************
+* File Name:   health_test.h
+*
+* Description: This file contains the interface of the SP 800-90B continuous
+* health tests run on every TRNG word of the HAL: MCU Cryptography: True
+* Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HEALTH_TEST_H
+#define HEALTH_TEST_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Words tested at every session start before any output is used. One full
+   adaptive proportion window */
+#define HEALTH_TEST_STARTUP_WORDS       (32u)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+typedef enum
+{
+    HEALTH_TEST_OK,
+    HEALTH_TEST_RCT_FAILURE,    /* Repetition count test failed */
+    HEALTH_TEST_APT_FAILURE     /* Adaptive proportion test failed */
+} health_test_status_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void health_test_start(void);
+bool health_test_feed(uint32_t word);
+health_test_status_t health_test_get_status(void);
+const char *health_test_status_name(health_test_status_t status);
+void health_test_clear(void);
+
+#endif /* HEALTH_TEST_H */
+
+/* [] END OF FILE */
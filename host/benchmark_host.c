@@ -0,0 +1,366 @@
+/******************************************************************************
+* File Name:   benchmark_host.c
+*
+* Description: This file contains the host benchmark of the HAL: MCU
+* Cryptography: True Random Number Generation Example. It runs the generation,
+* mapping and extraction code natively against the host backend of the TRNG
+* hardware shim, so algorithm changes can be compared quickly, for example in
+* CI, before the cycles are validated with BENCHMARK=1 on the board. Times are
+* wall clock nanoseconds per call.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#if defined(TRNG_HAL_HOST)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "trng_hal_host.h"
+#include "trng_session.h"
+#include "random_source.h"
+#include "trng_fill.h"
+#include "bit_reservoir.h"
+#include "alphabet.h"
+#include "alphabet_fixed.h"
+#include "otp_queue.h"
+#include "benchmark.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Calls timed together per sample, as a single call is below the clock
+   resolution of the host */
+#define HOST_BENCHMARK_BATCH            (64u)
+
+/* Characters per call of the alphabet mapping cases */
+#define HOST_BENCHMARK_MAP_LENGTH       (16u)
+
+/* Bits per call of the extraction case */
+#define HOST_BENCHMARK_EXTRACT_BITS     (6u)
+
+/* Words of the mock sequence used with -m */
+#define HOST_BENCHMARK_MOCK_WORDS       (4096u)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+typedef enum
+{
+    HOST_BENCHMARK_RAW_WORD,    /* One health tested word */
+    HOST_BENCHMARK_TRNG_FILL,   /* trng_fill() of BENCHMARK_FILL_SIZE bytes */
+    HOST_BENCHMARK_EXTRACT,     /* bit_reservoir_take() */
+    HOST_BENCHMARK_MAP,         /* alphabet_map() of one alphabet */
+    HOST_BENCHMARK_FIXED        /* Specialized generator of the OTP queue */
+} host_benchmark_case_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void run_case(host_benchmark_case_t bench_case, alphabet_id_t id);
+static cy_rslt_t run_call(host_benchmark_case_t bench_case, alphabet_id_t id);
+static uint64_t time_ns(void);
+static int compare_samples(const void *a, const void *b);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Nanoseconds per call of each sample */
+static uint64_t samples[BENCHMARK_ITERATIONS];
+
+static uint8_t fill_buffer[BENCHMARK_FILL_SIZE];
+
+static uint32_t mock_words[HOST_BENCHMARK_MOCK_WORDS];
+
+/* generate_fixed(): OTP_FIXED_LENGTH characters of OTP_FIXED_ALPHABET */
+ALPHABET_FIXED_GENERATOR(generate_fixed, OTP_FIXED_ALPHABET, OTP_FIXED_LENGTH)
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* This function opens the TRNG session on the host backend and runs all
+* cases. With -m, the words are replayed from a fixed sequence instead of
+* being read from TRNG_HAL_HOST_DEVICE, so the figures do not include the
+* device reads and are repeatable.
+*
+* Parameters:
+*  argc: Number of arguments
+*  argv: Arguments
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(int argc, char **argv)
+{
+    bool mock = (argc > 1) && (strcmp(argv[1], "-m") == 0);
+    uint32_t state = 0x12345678u;
+    uint32_t index;
+    uint32_t id;
+
+    if (mock)
+    {
+        /* xorshift32, passes the health tests */
+        for (index = 0; index < HOST_BENCHMARK_MOCK_WORDS; index++)
+        {
+            state ^= state << 13u;
+            state ^= state >> 17u;
+            state ^= state << 5u;
+            mock_words[index] = state;
+        }
+
+        trng_hal_host_set_mock(mock_words, HOST_BENCHMARK_MOCK_WORDS);
+    }
+
+    if ((trng_session_init() != CY_RSLT_SUCCESS) ||
+        (trng_session_open() != CY_RSLT_SUCCESS))
+    {
+        printf("TRNG session open failed\n");
+        return 1;
+    }
+
+    printf("Host benchmark: %u samples of %u calls per case, source %s\n",
+           BENCHMARK_ITERATIONS, HOST_BENCHMARK_BATCH,
+           mock ? "mock" : TRNG_HAL_HOST_DEVICE);
+    printf("%-20s %12s %12s %12s\n", "Case", "Median ns", "P99 ns",
+           "Bytes/s");
+
+    run_case(HOST_BENCHMARK_RAW_WORD, ALPHABET_COUNT);
+    run_case(HOST_BENCHMARK_TRNG_FILL, ALPHABET_COUNT);
+    run_case(HOST_BENCHMARK_EXTRACT, ALPHABET_COUNT);
+
+    for (id = 0; id < (uint32_t)ALPHABET_COUNT; id++)
+    {
+        run_case(HOST_BENCHMARK_MAP, (alphabet_id_t)id);
+    }
+
+    run_case(HOST_BENCHMARK_FIXED, ALPHABET_COUNT);
+
+    printf("%-20s %12lu\n", "TRNG words used",
+           (unsigned long)trng_hal_host_get_words());
+
+    return 0;
+}
+
+/*******************************************************************************
+* Function Name: run_case
+********************************************************************************
+* Summary:
+* This function measures BENCHMARK_ITERATIONS samples of one case and prints
+* the result line.
+*
+* Parameters:
+*  bench_case: Case to measure
+*  id: Alphabet of the mapping case
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void run_case(host_benchmark_case_t bench_case, alphabet_id_t id)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    char name[32];
+    uint64_t start;
+    uint64_t median;
+    uint32_t bytes;
+    uint32_t count;
+    uint32_t call;
+
+    switch (bench_case)
+    {
+        case HOST_BENCHMARK_RAW_WORD:
+            (void)snprintf(name, sizeof(name), "Raw TRNG word");
+            bytes = sizeof(uint32_t);
+            break;
+
+        case HOST_BENCHMARK_TRNG_FILL:
+            (void)snprintf(name, sizeof(name), "Bulk fill (TRNG)");
+            bytes = BENCHMARK_FILL_SIZE;
+            break;
+
+        case HOST_BENCHMARK_EXTRACT:
+            (void)snprintf(name, sizeof(name), "Extract %u bits",
+                           HOST_BENCHMARK_EXTRACT_BITS);
+            bytes = 0;
+            break;
+
+        case HOST_BENCHMARK_MAP:
+            (void)snprintf(name, sizeof(name), "Map %s",
+                           alphabet_get(id)->name);
+            bytes = HOST_BENCHMARK_MAP_LENGTH;
+            break;
+
+        default:
+            (void)snprintf(name, sizeof(name), "Fixed OTP generator");
+            bytes = OTP_FIXED_LENGTH;
+            break;
+    }
+
+    (void)random_source_select(RANDOM_SOURCE_TRNG);
+
+    for (count = 0; (count < BENCHMARK_ITERATIONS) &&
+                    (result == CY_RSLT_SUCCESS); count++)
+    {
+        start = time_ns();
+
+        for (call = 0; (call < HOST_BENCHMARK_BATCH) &&
+                       (result == CY_RSLT_SUCCESS); call++)
+        {
+            result = run_call(bench_case, id);
+        }
+
+        samples[count] = (time_ns() - start) / HOST_BENCHMARK_BATCH;
+    }
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        printf("%-20s failed\n", name);
+        return;
+    }
+
+    qsort(samples, BENCHMARK_ITERATIONS, sizeof(samples[0]), compare_samples);
+    median = samples[BENCHMARK_ITERATIONS / 2u];
+
+    printf("%-20s %12llu %12llu ", name, (unsigned long long)median,
+           (unsigned long long)samples[(BENCHMARK_ITERATIONS * 99u) / 100u]);
+
+    if ((bytes != 0u) && (median != 0u))
+    {
+        printf("%12llu\n",
+               (unsigned long long)((bytes * 1000000000ull) / median));
+    }
+    else
+    {
+        printf("%12s\n", "-");
+    }
+}
+
+/*******************************************************************************
+* Function Name: run_call
+********************************************************************************
+* Summary:
+* This function performs one measured call of a case.
+*
+* Parameters:
+*  bench_case: Case to run
+*  id: Alphabet of the mapping case
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t run_call(host_benchmark_case_t bench_case, alphabet_id_t id)
+{
+    cy_rslt_t result;
+    uint32_t word;
+
+    switch (bench_case)
+    {
+        case HOST_BENCHMARK_RAW_WORD:
+            result = trng_session_generate(&word);
+            break;
+
+        case HOST_BENCHMARK_TRNG_FILL:
+            result = trng_fill(fill_buffer, sizeof(fill_buffer));
+            break;
+
+        case HOST_BENCHMARK_EXTRACT:
+            result = bit_reservoir_take(HOST_BENCHMARK_EXTRACT_BITS, &word);
+            break;
+
+        case HOST_BENCHMARK_MAP:
+            result = alphabet_map(alphabet_get(id), fill_buffer,
+                                  HOST_BENCHMARK_MAP_LENGTH);
+            break;
+
+        default:
+            result = generate_fixed(fill_buffer);
+            break;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: time_ns
+********************************************************************************
+* Summary:
+* This function returns the monotonic clock in nanoseconds.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint64_t
+*
+*******************************************************************************/
+static uint64_t time_ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000ull) + (uint64_t)now.tv_nsec;
+}
+
+/*******************************************************************************
+* Function Name: compare_samples
+********************************************************************************
+* Summary:
+* qsort() comparison of two samples in ascending order.
+*
+* Parameters:
+*  a: First sample
+*  b: Second sample
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+static int compare_samples(const void *a, const void *b)
+{
+    uint64_t first = *(const uint64_t *)a;
+    uint64_t second = *(const uint64_t *)b;
+
+    return (first > second) - (first < second);
+}
+
+#endif /* TRNG_HAL_HOST */
+
+/* [] END OF FILE */
@@ -0,0 +1,173 @@
+/******************************************************************************
+* File Name:   cyhal.h
+*
+* Description: This file contains the subset of the HAL used by the generation,
+* mapping and health test code, for native builds on the host. The TRNG itself
+* is reached through trng_hal.h, whose host backend is host/trng_hal_host.c.
+* Critical sections are empty, as the host build runs in a single thread
+* without interrupts. Timer events fire only when the host program calls
+* cyhal_timer_host_tick() (host/cyhal_host.c). The crypto block is never
+* accessed: host/cyhal_host.c also holds the stubs of the crypto block, the
+* DRBG and the conditioner.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CYHAL_H
+#define CYHAL_H
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define CY_ASSERT(x)                    assert(x)
+#define CY_UNUSED_PARAMETER(x)          ((void)(x))
+
+#define __STATIC_FORCEINLINE            static inline \
+                                        __attribute__((always_inline))
+
+/* Orders the memory accesses of the refill path like the DMB instruction */
+#define __DMB()                         __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/* No connection pin */
+#define NC                              (0)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+/* Crypto block registers, only passed by pointer */
+typedef struct CRYPTO_Type CRYPTO_Type;
+
+typedef enum
+{
+    CYHAL_TIMER_DIR_UP,
+    CYHAL_TIMER_DIR_DOWN
+} cyhal_timer_direction_t;
+
+typedef enum
+{
+    CYHAL_TIMER_IRQ_NONE = 0,
+    CYHAL_TIMER_IRQ_TERMINAL_COUNT = 1,
+    CYHAL_TIMER_IRQ_CAPTURE_COMPARE = 2
+} cyhal_timer_event_t;
+
+typedef struct
+{
+    bool is_continuous;
+    cyhal_timer_direction_t direction;
+    bool is_compare;
+    uint32_t period;
+    uint32_t compare_value;
+    uint32_t value;
+} cyhal_timer_cfg_t;
+
+typedef void (*cyhal_timer_event_callback_t)(void *callback_arg,
+                                             cyhal_timer_event_t event);
+
+typedef struct cyhal_timer_s
+{
+    bool running;
+    bool event_enabled;
+    bool is_continuous;
+    uint32_t frequency_hz;
+    uint32_t period;
+    uint32_t value;                 /* Counter, advanced by the ticks */
+    cyhal_timer_event_callback_t callback;
+    void *callback_arg;
+    struct cyhal_timer_s *next;     /* Next initialized timer */
+} cyhal_timer_t;
+
+/* Counts the leading zero bits like the CLZ instruction, 32 for 0. */
+__STATIC_FORCEINLINE uint32_t __CLZ(uint32_t value)
+{
+    return (value == 0u) ? 32u : (uint32_t)__builtin_clz(value);
+}
+
+/* Reverses the bit order like the RBIT instruction. */
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value)
+{
+    uint32_t result = 0;
+    uint32_t bit;
+
+    for (bit = 0; bit < 32u; bit++)
+    {
+        result = (result << 1u) | ((value >> bit) & 1u);
+    }
+
+    return result;
+}
+
+/* No interrupts on the host. */
+static inline uint32_t cyhal_system_critical_section_enter(void)
+{
+    return 0u;
+}
+
+static inline void cyhal_system_critical_section_exit(uint32_t old_state)
+{
+    CY_UNUSED_PARAMETER(old_state);
+}
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+/* Timers only advance when the host program calls cyhal_timer_host_tick(),
+   so the benchmark never sees the TRNG session closed by the idle timeout */
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, int pin, const void *clk);
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj,
+                                const cyhal_timer_cfg_t *cfg);
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t *obj, uint32_t hz);
+void cyhal_timer_register_callback(cyhal_timer_t *obj,
+                                   cyhal_timer_event_callback_t callback,
+                                   void *callback_arg);
+void cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event,
+                              uint8_t intr_priority, bool enable);
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj);
+cy_rslt_t cyhal_timer_stop(cyhal_timer_t *obj);
+void cyhal_timer_host_tick(void);
+
+/* Host stub counters, see host/cyhal_host.c */
+uint32_t crypto_block_host_get_resets(void);
+uint32_t drbg_host_get_key_loads(void);
+
+#endif /* CYHAL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,627 @@
+/******************************************************************************
+* File Name:   cyhal_host.c
+*
+* Description: This file contains the host timers of the HAL subset in
+* host/cyhal.h and the stubs of the crypto block, the DRBG and the
+* conditioner. Each call of cyhal_timer_host_tick() advances every running
+* timer by one millisecond at its frequency and fires its terminal count event
+* when its period elapses, so a host test can drive the refill, idle and
+* backoff timers step by step. The conditioner stub passes the entropy pool
+* words on without hashing, and the DRBG stub keeps the reseed counter of
+* drbg.c around an xorshift generator seeded from the conditioner.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#if defined(TRNG_HAL_HOST)
+
+#include <string.h>
+#include "cyhal.h"
+#include "crypto_block.h"
+#include "conditioner.h"
+#include "drbg.h"
+#include "entropy_pool.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Time advanced by one cyhal_timer_host_tick() call */
+#define HOST_TICK_PER_SECOND            (1000u)
+
+/* Conditioner words taken per reseed, as for the 48-byte seed of drbg.c */
+#define DRBG_HOST_SEED_WORDS            (12u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Timers initialized since the start of the program */
+static cyhal_timer_t *timer_list = NULL;
+
+/* Crypto block resets, and keys loaded again after one */
+static bool crypto_suspended = false;
+static uint32_t crypto_resets = 0;
+static uint32_t drbg_key_loads = 0;
+
+/* DRBG stub state */
+static uint32_t drbg_state = 0;
+static uint32_t drbg_reseed_counter = 0;
+static uint32_t drbg_reseed_interval = DRBG_DEFAULT_RESEED_INTERVAL;
+static bool drbg_instantiated = false;
+
+/*******************************************************************************
+* Function Name: cyhal_timer_init
+********************************************************************************
+* Summary:
+* This function adds a timer to the timers fired by cyhal_timer_host_tick().
+*
+* Parameters:
+*  obj: Timer
+*  pin: Not used
+*  clk: Not used
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, int pin, const void *clk)
+{
+    CY_UNUSED_PARAMETER(pin);
+    CY_UNUSED_PARAMETER(clk);
+
+    obj->running = false;
+    obj->event_enabled = false;
+    obj->is_continuous = false;
+    obj->frequency_hz = 0;
+    obj->period = 0;
+    obj->value = 0;
+    obj->callback = NULL;
+    obj->callback_arg = NULL;
+    obj->next = timer_list;
+    timer_list = obj;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_timer_configure
+********************************************************************************
+* Summary:
+* This function sets the period, the counter and the mode of a timer. Only
+* up-counting timers are modelled.
+*
+* Parameters:
+*  obj: Timer
+*  cfg: Timer configuration
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj,
+                                const cyhal_timer_cfg_t *cfg)
+{
+    obj->is_continuous = cfg->is_continuous;
+    obj->period = cfg->period;
+    obj->value = cfg->value;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_timer_set_frequency
+********************************************************************************
+* Summary:
+* This function sets the counter frequency of a timer. A frequency below
+* HOST_TICK_PER_SECOND never advances the counter.
+*
+* Parameters:
+*  obj: Timer
+*  hz: Counter frequency
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t *obj, uint32_t hz)
+{
+    obj->frequency_hz = hz;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_timer_register_callback
+********************************************************************************
+* Summary:
+* This function records the event handler of a timer.
+*
+* Parameters:
+*  obj: Timer
+*  callback: Event handler
+*  callback_arg: Argument passed to the handler
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cyhal_timer_register_callback(cyhal_timer_t *obj,
+                                   cyhal_timer_event_callback_t callback,
+                                   void *callback_arg)
+{
+    obj->callback = callback;
+    obj->callback_arg = callback_arg;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_timer_enable_event
+********************************************************************************
+* Summary:
+* This function enables or disables the terminal count event of a timer.
+*
+* Parameters:
+*  obj: Timer
+*  event: Not used, only the terminal count event exists on the host
+*  intr_priority: Not used
+*  enable: true to enable the event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event,
+                              uint8_t intr_priority, bool enable)
+{
+    CY_UNUSED_PARAMETER(event);
+    CY_UNUSED_PARAMETER(intr_priority);
+
+    obj->event_enabled = enable;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_timer_start
+********************************************************************************
+* Summary:
+* This function starts a timer.
+*
+* Parameters:
+*  obj: Timer
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj)
+{
+    obj->running = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_timer_stop
+********************************************************************************
+* Summary:
+* This function stops a timer.
+*
+* Parameters:
+*  obj: Timer
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t cyhal_timer_stop(cyhal_timer_t *obj)
+{
+    obj->running = false;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: cyhal_timer_host_tick
+********************************************************************************
+* Summary:
+* This function advances every running timer by one millisecond and calls
+* the terminal count handler of each timer whose period elapsed, in place of
+* the timer interrupts of the device. A one-shot timer stops at its terminal
+* count.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cyhal_timer_host_tick(void)
+{
+    cyhal_timer_t *timer;
+
+    for (timer = timer_list; timer != NULL; timer = timer->next)
+    {
+        if (timer->running)
+        {
+            timer->value += (timer->frequency_hz / HOST_TICK_PER_SECOND);
+        }
+
+        while (timer->running && (timer->value > timer->period))
+        {
+            timer->value -= (timer->period + 1u);
+
+            if (!timer->is_continuous)
+            {
+                timer->running = false;
+                timer->value = 0;
+            }
+
+            if (timer->event_enabled && (timer->callback != NULL))
+            {
+                timer->callback(timer->callback_arg,
+                                CYHAL_TIMER_IRQ_TERMINAL_COUNT);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: crypto_block_reserve
+********************************************************************************
+* Summary:
+* This function stands in for the reservation of the crypto block, which does
+* not exist on the host.
+*
+* Parameters:
+*  base: Location to store the NULL register base
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t crypto_block_reserve(CRYPTO_Type **base)
+{
+    *base = NULL;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: crypto_block_suspend
+********************************************************************************
+* Summary:
+* This function records that the crypto block is powered off.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void crypto_block_suspend(void)
+{
+    crypto_suspended = true;
+}
+
+/*******************************************************************************
+* Function Name: crypto_block_resume
+********************************************************************************
+* Summary:
+* This function counts a reset, a suspend followed by a resume, of the crypto
+* block.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void crypto_block_resume(void)
+{
+    if (crypto_suspended)
+    {
+        crypto_suspended = false;
+        crypto_resets++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: crypto_block_host_get_resets
+********************************************************************************
+* Summary:
+* This function returns the number of crypto block resets.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t crypto_block_host_get_resets(void)
+{
+    return crypto_resets;
+}
+
+/*******************************************************************************
+* Function Name: conditioner_init
+********************************************************************************
+* Summary:
+* This function stands in for the start of the SHA-256 conditioner.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t conditioner_init(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: conditioner_get
+********************************************************************************
+* Summary:
+* This function returns the next entropy pool word unhashed, so the tests can
+* compare the output with the mock sequence of the TRNG backend.
+*
+* Parameters:
+*  value: Location to store the word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t conditioner_get(uint32_t *value)
+{
+    return entropy_pool_get(value);
+}
+
+/*******************************************************************************
+* Function Name: conditioner_flush
+********************************************************************************
+* Summary:
+* This function does nothing, as the stub buffers no output.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void conditioner_flush(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: drbg_init
+********************************************************************************
+* Summary:
+* This function instantiates the DRBG stub from the conditioner.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t drbg_init(void)
+{
+    return drbg_reseed();
+}
+
+/*******************************************************************************
+* Function Name: drbg_reseed
+********************************************************************************
+* Summary:
+* This function mixes DRBG_HOST_SEED_WORDS conditioner words into the state
+* and resets the reseed counter, as drbg_reseed() of drbg.c does.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t drbg_reseed(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t state = drbg_state;
+    uint32_t random_val;
+    uint32_t count;
+
+    for (count = 0; (count < DRBG_HOST_SEED_WORDS) &&
+         (result == CY_RSLT_SUCCESS); count++)
+    {
+        result = conditioner_get(&random_val);
+        state ^= random_val;
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        /* Zero is a fixed point of xorshift */
+        drbg_state = (state != 0u) ? state : 1u;
+        drbg_reseed_counter = 1u;
+        drbg_instantiated = true;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: drbg_generate
+********************************************************************************
+* Summary:
+* This function produces xorshift32 bytes. The stub is reseeded first when
+* the reseed interval has been reached.
+*
+* Parameters:
+*  out: Buffer for the output
+*  length: Number of bytes, at most DRBG_MAX_REQUEST_BYTES
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t drbg_generate(uint8_t *out, uint32_t length)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t chunk;
+
+    if (!drbg_instantiated)
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    if (length > DRBG_MAX_REQUEST_BYTES)
+    {
+        return APP_RSLT_ERR_BAD_PARAM;
+    }
+
+    if (drbg_reseed_counter > drbg_reseed_interval)
+    {
+        result = drbg_reseed();
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        while (length > 0u)
+        {
+            drbg_state ^= drbg_state << 13u;
+            drbg_state ^= drbg_state >> 17u;
+            drbg_state ^= drbg_state << 5u;
+            chunk = (length > sizeof(drbg_state)) ? sizeof(drbg_state) : length;
+            memcpy(out, &drbg_state, chunk);
+            out += chunk;
+            length -= chunk;
+        }
+
+        drbg_reseed_counter++;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: drbg_set_reseed_interval
+********************************************************************************
+* Summary:
+* This function sets the number of generate requests between two reseeds.
+*
+* Parameters:
+*  interval: 1 to DRBG_MAX_RESEED_INTERVAL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void drbg_set_reseed_interval(uint32_t interval)
+{
+    if ((interval > 0u) && (interval <= DRBG_MAX_RESEED_INTERVAL))
+    {
+        drbg_reseed_interval = interval;
+    }
+}
+
+/*******************************************************************************
+* Function Name: drbg_get_reseed_interval
+********************************************************************************
+* Summary:
+* This function returns the number of generate requests between two reseeds.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t drbg_get_reseed_interval(void)
+{
+    return drbg_reseed_interval;
+}
+
+/*******************************************************************************
+* Function Name: drbg_reload_key
+********************************************************************************
+* Summary:
+* This function counts a load of the key into the reset crypto block.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t drbg_reload_key(void)
+{
+    if (drbg_instantiated)
+    {
+        drbg_key_loads++;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: drbg_host_get_key_loads
+********************************************************************************
+* Summary:
+* This function returns the number of keys loaded again after a reset.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t drbg_host_get_key_loads(void)
+{
+    return drbg_key_loads;
+}
+
+#endif /* TRNG_HAL_HOST */
+
+/* [] END OF FILE */
@@ -0,0 +1,1040 @@
+/******************************************************************************
+* File Name:   test_host.c
+*
+* Description: This file contains the host unit tests. The health tests are
+* fed from scripted mock sequences of the TRNG backend, the alphabets are
+* checked for range and uniformity, trng_fill() and the bit reservoir are
+* compared bit for bit with the mock sequence, and the entropy pool, the fault
+* recovery and the random source are driven through cyhal_timer_host_tick(),
+* one millisecond per call. The program returns 1 if any check failed, so
+* "make -C host test" can run in CI.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#if defined(TRNG_HAL_HOST)
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "trng_hal_host.h"
+#include "trng_session.h"
+#include "trng_recovery.h"
+#include "health_test.h"
+#include "entropy_pool.h"
+#include "random_source.h"
+#include "drbg.h"
+#include "trng_fill.h"
+#include "bit_reservoir.h"
+#include "alphabet.h"
+#include "alphabet_fixed.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Records a failed check with its location and continues with the test */
+#define CHECK(condition)    check((condition), #condition, __FILE__, __LINE__)
+
+/* Words of the xorshift32 mock sequence, which passes the health tests */
+#define TEST_MOCK_WORDS                 (256u)
+
+/* Characters drawn per alphabet character in the uniformity tests */
+#define TEST_DRAWS_PER_CHAR             (2000u)
+
+/* Characters mapped per call in the uniformity tests */
+#define TEST_MAP_LENGTH                 (25u)
+
+/* Word with 25 ones and no run longer than 7 bits across words */
+#define TEST_WORD_25_ONES               (0xFDDDDDDDu)
+
+/* Word with 24 ones and no run longer than 7 bits across words */
+#define TEST_WORD_24_ONES               (0xDDDDDDDDu)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void check(bool condition, const char *text, const char *file,
+                  int line);
+static void reset_source(const uint32_t *words, uint32_t count);
+static uint32_t open_session(const uint32_t *words, uint32_t count);
+static void check_distribution(const char *chars, uint32_t size,
+                               const uint32_t *counts, uint32_t draws);
+static void tick_ms(uint32_t ms);
+static void test_health_rct(void);
+static void test_health_apt(void);
+static void test_health_good(void);
+static void test_alphabet_char(void);
+static void test_alphabet_map(void);
+static void test_alphabet_map_fixed(void);
+static void test_alphabet_fixed_bits(void);
+static void test_trng_fill(void);
+static void test_bit_reservoir(void);
+static void test_entropy_pool(void);
+static void test_trng_recovery(void);
+static void test_random_source(void);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Characters of each alphabet, in index order */
+static const char *const alphabet_chars[ALPHABET_COUNT] =
+{
+    [ALPHABET_PRINTABLE] = "!\"#$%&'()*+,-./0123456789:;<=>?@"
+                           "ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`"
+                           "abcdefghijklmnopqrstuvwxyz{|}~",
+    [ALPHABET_ALPHANUMERIC] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                              "abcdefghijklmnopqrstuvwxyz",
+    [ALPHABET_BASE32] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567",
+    [ALPHABET_HEX] = "0123456789abcdef"
+};
+
+static const uint32_t stuck_words[] = { 0x00000000u };
+static const uint32_t biased_words[] = { TEST_WORD_25_ONES };
+static uint32_t mock_words[TEST_MOCK_WORDS];
+
+static uint32_t checks = 0;
+static uint32_t failures = 0;
+
+/* generate_*(): fixed generators of three alphabets, one with rejections */
+ALPHABET_FIXED_GENERATOR(generate_printable, PRINTABLE, TEST_MAP_LENGTH)
+ALPHABET_FIXED_GENERATOR(generate_alphanumeric, ALPHANUMERIC, TEST_MAP_LENGTH)
+ALPHABET_FIXED_GENERATOR(generate_hex, HEX, TEST_MAP_LENGTH)
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* This function prepares the mock sequence, runs all tests and prints the
+* number of failed checks.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  int: 0 if all checks passed, 1 otherwise
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32_t state = 0x12345678u;
+    uint32_t index;
+
+    for (index = 0; index < TEST_MOCK_WORDS; index++)
+    {
+        state ^= state << 13u;
+        state ^= state >> 17u;
+        state ^= state << 5u;
+        mock_words[index] = state;
+    }
+
+    if ((trng_session_init() != CY_RSLT_SUCCESS) ||
+        (trng_recovery_init() != CY_RSLT_SUCCESS) ||
+        (entropy_pool_init() != CY_RSLT_SUCCESS) ||
+        (drbg_init() != CY_RSLT_SUCCESS))
+    {
+        printf("Host test init failed\n");
+        return 1;
+    }
+
+    test_health_rct();
+    test_health_apt();
+    test_health_good();
+    test_alphabet_char();
+    test_alphabet_map();
+    test_alphabet_map_fixed();
+    test_alphabet_fixed_bits();
+    test_trng_fill();
+    test_bit_reservoir();
+    test_entropy_pool();
+    test_trng_recovery();
+
+    /* Last, as it gives the TRNG up */
+    test_random_source();
+
+    printf("Host test: %lu checks, %lu failed\n", (unsigned long)checks,
+           (unsigned long)failures);
+
+    return (failures == 0u) ? 0 : 1;
+}
+
+/*******************************************************************************
+* Function Name: check
+********************************************************************************
+* Summary:
+* This function counts a check and reports it if it failed.
+*
+* Parameters:
+*  condition: Result of the check
+*  text: Checked expression
+*  file: Source file of the check
+*  line: Source line of the check
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void check(bool condition, const char *text, const char *file,
+                  int line)
+{
+    checks++;
+
+    if (!condition)
+    {
+        failures++;
+        printf("%s:%d: check failed: %s\n", file, line, text);
+    }
+}
+
+/*******************************************************************************
+* Function Name: reset_source
+********************************************************************************
+* Summary:
+* This function closes the TRNG session, selects the words of the backend,
+* clears the health tests and discards the words of the entropy pool and the
+* bits kept by trng_fill() and the bit reservoir.
+*
+* Parameters:
+*  words: Mock sequence, NULL for TRNG_HAL_HOST_DEVICE
+*  count: Number of words of the sequence
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void reset_source(const uint32_t *words, uint32_t count)
+{
+    trng_session_close();
+    trng_hal_host_set_mock(words, count);
+    health_test_clear();
+    entropy_pool_flush();
+    trng_fill_flush();
+    bit_reservoir_flush();
+}
+
+/*******************************************************************************
+* Function Name: open_session
+********************************************************************************
+* Summary:
+* This function resets the source to a mock sequence and opens the TRNG
+* session, whose startup test uses the first words of the sequence.
+*
+* Parameters:
+*  words: Mock sequence
+*  count: Number of words of the sequence
+*
+* Return:
+*  uint32_t: Index of the next word the session generates
+*
+*******************************************************************************/
+static uint32_t open_session(const uint32_t *words, uint32_t count)
+{
+    uint32_t base;
+
+    reset_source(words, count);
+    base = trng_hal_host_get_words();
+    CHECK(trng_session_open() == CY_RSLT_SUCCESS);
+
+    return (trng_hal_host_get_words() - base) % count;
+}
+
+/*******************************************************************************
+* Function Name: check_distribution
+********************************************************************************
+* Summary:
+* This function checks that every character of an alphabet was drawn with
+* the same probability. The chi-squared statistic must stay below its mean
+* plus ten standard deviations, which a uniform generator exceeds with a
+* negligible probability, while modulo bias exceeds it by far.
+*
+* Parameters:
+*  chars: Characters of the alphabet
+*  size: Number of characters
+*  counts: Draws of each character, by character code
+*  draws: Total number of draws
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void check_distribution(const char *chars, uint32_t size,
+                               const uint32_t *counts, uint32_t draws)
+{
+    double expected = (double)draws / size;
+    double degrees = (double)(size - 1u);
+    double chi_squared = 0.0;
+    double deviation;
+    uint32_t index;
+
+    for (index = 0; index < size; index++)
+    {
+        deviation = (double)counts[(uint8_t)chars[index]] - expected;
+        chi_squared += (deviation * deviation) / expected;
+    }
+
+    CHECK(chi_squared < (degrees + (10.0 * sqrt(2.0 * degrees))));
+}
+
+/*******************************************************************************
+* Function Name: tick_ms
+********************************************************************************
+* Summary:
+* This function lets time pass for the host timers.
+*
+* Parameters:
+*  ms: Milliseconds
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void tick_ms(uint32_t ms)
+{
+    uint32_t tick;
+
+    for (tick = 0; tick < ms; tick++)
+    {
+        cyhal_timer_host_tick();
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_health_rct
+********************************************************************************
+* Summary:
+* This function tests the repetition count test at its cutoff of 41 bits. A
+* run of 40 equal bits across words passes and a run of 41 fails. A stuck
+* TRNG fails the startup test, and the failure stays latched.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_health_rct(void)
+{
+    /* 8 ones ending the first word, 32 in the second, then the run ends */
+    health_test_clear();
+    CHECK(health_test_feed(0xFF000000u));
+    CHECK(health_test_feed(0xFFFFFFFFu));
+    CHECK(health_test_feed(0xAAAAAAAAu));
+    CHECK(health_test_get_status() == HEALTH_TEST_OK);
+
+    /* The same run, continued by one more bit */
+    health_test_clear();
+    CHECK(health_test_feed(0xFF000000u));
+    CHECK(health_test_feed(0xFFFFFFFFu));
+    CHECK(!health_test_feed(0x55555555u));
+    CHECK(health_test_get_status() == HEALTH_TEST_RCT_FAILURE);
+
+    /* Latched until cleared, even for good words */
+    CHECK(!health_test_feed(0xAAAAAAAAu));
+    CHECK(health_test_get_status() == HEALTH_TEST_RCT_FAILURE);
+
+    /* A stuck word fails the startup test of the session */
+    reset_source(stuck_words, 1u);
+    CHECK(trng_session_open() == APP_RSLT_ERR_HEALTH_TEST);
+    CHECK(!trng_session_is_open());
+    CHECK(health_test_get_status() == HEALTH_TEST_RCT_FAILURE);
+}
+
+/*******************************************************************************
+* Function Name: test_health_apt
+********************************************************************************
+* Summary:
+* This function tests the adaptive proportion test at its cutoff of 793
+* equal bits in a window of 1024. 24 ones per word (768 per window) pass,
+* 25 ones per word fail on the 32nd word (800), and a later repetition count
+* failure does not replace the latched cause.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_health_apt(void)
+{
+    uint32_t index;
+    bool passed = true;
+
+    health_test_clear();
+    for (index = 0; index < (3u * 32u); index++)
+    {
+        passed = health_test_feed(TEST_WORD_24_ONES) && passed;
+    }
+    CHECK(passed);
+
+    health_test_clear();
+    for (index = 0; index < 31u; index++)
+    {
+        passed = health_test_feed(TEST_WORD_25_ONES) && passed;
+    }
+    CHECK(passed);
+    CHECK(!health_test_feed(TEST_WORD_25_ONES));
+    CHECK(health_test_get_status() == HEALTH_TEST_APT_FAILURE);
+
+    /* Only the first failure is latched */
+    (void)health_test_feed(0x00000000u);
+    (void)health_test_feed(0x00000000u);
+    CHECK(health_test_get_status() == HEALTH_TEST_APT_FAILURE);
+
+    /* A biased TRNG fails the startup test, one full window */
+    reset_source(biased_words, 1u);
+    CHECK(trng_session_open() == APP_RSLT_ERR_HEALTH_TEST);
+    CHECK(health_test_get_status() == HEALTH_TEST_APT_FAILURE);
+}
+
+/*******************************************************************************
+* Function Name: test_health_good
+********************************************************************************
+* Summary:
+* This function checks that words of TRNG_HAL_HOST_DEVICE pass the startup
+* test and many windows of both tests.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_health_good(void)
+{
+    uint32_t index;
+    uint32_t word;
+    bool passed = true;
+
+    reset_source(NULL, 0u);
+    CHECK(trng_session_open() == CY_RSLT_SUCCESS);
+
+    for (index = 0; index < 100000u; index++)
+    {
+        passed = (trng_session_generate(&word) == CY_RSLT_SUCCESS) && passed;
+    }
+
+    CHECK(passed);
+    CHECK(health_test_get_status() == HEALTH_TEST_OK);
+}
+
+/*******************************************************************************
+* Function Name: test_alphabet_char
+********************************************************************************
+* Summary:
+* This function checks the character of every index of every alphabet, that
+* the candidate bit count is the smallest one that covers the alphabet, and
+* that every accepted group candidate is split into the right characters.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_alphabet_char(void)
+{
+    const alphabet_t *alphabet;
+    uint8_t chars[8];
+    uint64_t group_size;
+    uint32_t id;
+    uint32_t index;
+    uint32_t digit;
+    uint32_t value;
+    bool matched;
+
+    for (id = 0; id < (uint32_t)ALPHABET_COUNT; id++)
+    {
+        alphabet = alphabet_get((alphabet_id_t)id);
+        matched = true;
+
+        CHECK(alphabet->size == strlen(alphabet_chars[id]));
+        CHECK(((1u << alphabet->bits) >= alphabet->size) &&
+              ((1u << (alphabet->bits - 1u)) < alphabet->size));
+
+        for (index = 0; index < alphabet->size; index++)
+        {
+            matched = (alphabet_char(alphabet->first, alphabet->steps, index)
+                       == (uint8_t)alphabet_chars[id][index]) && matched;
+        }
+
+        CHECK(matched);
+
+        group_size = 1u;
+        for (digit = 0; digit < alphabet->group; digit++)
+        {
+            group_size *= alphabet->size;
+        }
+
+        CHECK((alphabet->group > 0u) && (alphabet->group <= sizeof(chars)));
+        CHECK(alphabet->group_size == group_size);
+        CHECK(((1ull << alphabet->group_bits) >= group_size) &&
+              ((1ull << (alphabet->group_bits - 1u)) < group_size));
+
+        for (index = 0; index < alphabet->group_size; index++)
+        {
+            alphabet_group_chars(alphabet->first, alphabet->steps,
+                                 alphabet->size, alphabet->reciprocal, index,
+                                 chars, alphabet->group);
+
+            for (digit = 0, value = index; digit < alphabet->group; digit++)
+            {
+                matched = (chars[digit] == (uint8_t)alphabet_chars[id]
+                           [value % alphabet->size]) && matched;
+                value /= alphabet->size;
+            }
+        }
+
+        CHECK(matched);
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_alphabet_map
+********************************************************************************
+* Summary:
+* This function checks that alphabet_map() only writes characters of the
+* alphabet and draws them uniformly, for every alphabet.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_alphabet_map(void)
+{
+    const alphabet_t *alphabet;
+    uint8_t out[TEST_MAP_LENGTH];
+    uint32_t counts[256];
+    uint32_t draws;
+    uint32_t id;
+    uint32_t index;
+    bool generated;
+    bool in_range;
+
+    reset_source(NULL, 0u);
+
+    for (id = 0; id < (uint32_t)ALPHABET_COUNT; id++)
+    {
+        alphabet = alphabet_get((alphabet_id_t)id);
+        memset(counts, 0, sizeof(counts));
+        generated = true;
+        in_range = true;
+
+        for (draws = 0; draws < (alphabet->size * TEST_DRAWS_PER_CHAR);
+             draws += TEST_MAP_LENGTH)
+        {
+            generated = (alphabet_map(alphabet, out, sizeof(out)) ==
+                         CY_RSLT_SUCCESS) && generated;
+
+            for (index = 0; index < TEST_MAP_LENGTH; index++)
+            {
+                in_range = (memchr(alphabet_chars[id], out[index],
+                                   alphabet->size) != NULL) && in_range;
+                counts[out[index]]++;
+            }
+        }
+
+        CHECK(generated);
+        CHECK(in_range);
+        check_distribution(alphabet_chars[id], alphabet->size, counts, draws);
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_alphabet_map_fixed
+********************************************************************************
+* Summary:
+* This function checks the generators of ALPHABET_FIXED_GENERATOR() like
+* test_alphabet_map(), for a power-of-two alphabet and two with rejections.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_alphabet_map_fixed(void)
+{
+    static const alphabet_id_t ids[] =
+    {
+        ALPHABET_PRINTABLE, ALPHABET_ALPHANUMERIC, ALPHABET_HEX
+    };
+    static cy_rslt_t (*const generators[])(uint8_t *out) =
+    {
+        generate_printable, generate_alphanumeric, generate_hex
+    };
+    const alphabet_t *alphabet;
+    uint8_t out[TEST_MAP_LENGTH];
+    uint32_t counts[256];
+    uint32_t draws;
+    uint32_t test;
+    uint32_t index;
+    bool generated;
+    bool in_range;
+
+    reset_source(NULL, 0u);
+
+    for (test = 0; test < (sizeof(ids) / sizeof(ids[0])); test++)
+    {
+        alphabet = alphabet_get(ids[test]);
+        memset(counts, 0, sizeof(counts));
+        generated = true;
+        in_range = true;
+
+        for (draws = 0; draws < (alphabet->size * TEST_DRAWS_PER_CHAR);
+             draws += TEST_MAP_LENGTH)
+        {
+            generated = (generators[test](out) == CY_RSLT_SUCCESS) &&
+                        generated;
+
+            for (index = 0; index < TEST_MAP_LENGTH; index++)
+            {
+                in_range = (memchr(alphabet_chars[ids[test]], out[index],
+                                   alphabet->size) != NULL) && in_range;
+                counts[out[index]]++;
+            }
+        }
+
+        CHECK(generated);
+        CHECK(in_range);
+        check_distribution(alphabet_chars[ids[test]], alphabet->size, counts,
+                           draws);
+    }
+}
+
+/*******************************************************************************
+* Function Name: test_alphabet_fixed_bits
+********************************************************************************
+* Summary:
+* This function checks that the ALPHABET_FIXED_GENERATOR() generators use
+* every bit of the random words: the characters are the digits of the
+* accepted candidates of the mock sequence cut into consecutive fields, a
+* group candidate while a group fits and single candidates for the rest, and
+* only the words that hold these candidates are taken from the TRNG, across
+* calls.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_alphabet_fixed_bits(void)
+{
+    const alphabet_t *alphabet = alphabet_get(ALPHABET_PRINTABLE);
+    uint8_t out[TEST_MAP_LENGTH];
+    uint64_t stream = 0;
+    uint32_t stream_bits = 0;
+    uint32_t used_bits = 0;
+    uint32_t candidate;
+    uint32_t count;
+    uint32_t bits;
+    uint32_t digit;
+    uint32_t base;
+    uint32_t next;
+    uint32_t index = 0;
+    bool matched = true;
+
+    /* No rejections: 2 * 25 hex characters take 200 bits, 7 words */
+    (void)open_session(mock_words, TEST_MOCK_WORDS);
+    base = trng_hal_host_get_words();
+    CHECK(generate_hex(out) == CY_RSLT_SUCCESS);
+    CHECK(generate_hex(out) == CY_RSLT_SUCCESS);
+    CHECK((trng_hal_host_get_words() - base) ==
+          (((2u * TEST_MAP_LENGTH * 4u) + 31u) / 32u));
+
+    next = open_session(mock_words, TEST_MOCK_WORDS);
+    base = trng_hal_host_get_words();
+    CHECK(generate_printable(out) == CY_RSLT_SUCCESS);
+
+    while (index < TEST_MAP_LENGTH)
+    {
+        count = ((TEST_MAP_LENGTH - index) >= alphabet->group) ?
+                alphabet->group : 1u;
+        bits = (count > 1u) ? alphabet->group_bits : alphabet->bits;
+
+        if (stream_bits < bits)
+        {
+            stream |= (uint64_t)mock_words[next] << stream_bits;
+            stream_bits += 32u;
+            next = (next + 1u) % TEST_MOCK_WORDS;
+        }
+
+        candidate = (uint32_t)(stream & ((1u << bits) - 1u));
+        stream >>= bits;
+        stream_bits -= bits;
+        used_bits += bits;
+
+        if (candidate < ((count > 1u) ? alphabet->group_size :
+                         alphabet->size))
+        {
+            for (digit = 0; digit < count; digit++)
+            {
+                matched = (out[index] == (uint8_t)alphabet_chars
+                           [ALPHABET_PRINTABLE][candidate % alphabet->size])
+                          && matched;
+                candidate /= alphabet->size;
+                index++;
+            }
+        }
+    }
+
+    CHECK(alphabet->group > 1u);
+    CHECK(matched);
+    CHECK((trng_hal_host_get_words() - base) == ((used_bits + 31u) / 32u));
+}
+
+/*******************************************************************************
+* Function Name: test_trng_fill
+********************************************************************************
+* Summary:
+* This function fills unaligned buffers with lengths that are no multiple of
+* a word and checks that the bytes of all calls together are the bytes of
+* the mock sequence, in order: the rest of a word is carried into the next
+* call. After trng_fill_flush(), the next call starts with a new word.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_trng_fill(void)
+{
+    static const uint8_t lengths[] = { 1u, 3u, 4u, 5u, 7u, 2u, 64u, 9u, 0u,
+                                       13u, 6u, 31u };
+    uint8_t expected[8u * TEST_MOCK_WORDS];
+    uint8_t buffer[128];
+    uint8_t *buf;
+    uint32_t next;
+    uint32_t offset;
+    uint32_t call;
+    uint32_t word;
+
+    next = open_session(mock_words, TEST_MOCK_WORDS);
+
+    for (word = 0; word < (2u * TEST_MOCK_WORDS); word++)
+    {
+        memcpy(&expected[word * 4u],
+               &mock_words[(next + word) % TEST_MOCK_WORDS], 4u);
+    }
+
+    offset = 0;
+
+    for (call = 0; call < (sizeof(lengths) / sizeof(lengths[0])); call++)
+    {
+        /* Start at 1, 2, 3 or 0 bytes past a word boundary */
+        buf = &buffer[(call + 1u) % 4u];
+
+        memset(buffer, 0, sizeof(buffer));
+        CHECK(trng_fill(buf, lengths[call]) == CY_RSLT_SUCCESS);
+        CHECK(memcmp(buf, &expected[offset], lengths[call]) == 0);
+        offset += lengths[call];
+    }
+
+    /* The carried bytes of the last word are dropped */
+    trng_fill_flush();
+    offset = (offset + 3u) & ~3u;
+
+    CHECK(trng_fill(&buffer[1], 10u) == CY_RSLT_SUCCESS);
+    CHECK(memcmp(&buffer[1], &expected[offset], 10u) == 0);
+}
+
+/*******************************************************************************
+* Function Name: test_bit_reservoir
+********************************************************************************
+* Summary:
+* This function takes bits in several sizes and checks that they are the bits
+* of the mock sequence, lowest bit first, with a refill only when fewer bits
+* are held than requested. bit_reservoir_flush() empties the reservoir, so
+* the next take starts with a new word.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_bit_reservoir(void)
+{
+    static const uint8_t sizes[] = { 5u, 7u, 1u, 32u, 20u, 6u, 13u, 31u, 4u };
+    uint64_t stream = 0;
+    uint32_t stream_bits = 0;
+    uint32_t next;
+    uint32_t value;
+    uint32_t take;
+    uint32_t bits;
+    bool matched = true;
+    bool level_ok = true;
+
+    next = open_session(mock_words, TEST_MOCK_WORDS);
+
+    for (take = 0; take < (8u * (sizeof(sizes) / sizeof(sizes[0]))); take++)
+    {
+        bits = sizes[take % (sizeof(sizes) / sizeof(sizes[0]))];
+
+        if (stream_bits < bits)
+        {
+            stream |= (uint64_t)mock_words[next] << stream_bits;
+            stream_bits += 32u;
+            next = (next + 1u) % TEST_MOCK_WORDS;
+        }
+
+        matched = (bit_reservoir_take((uint8_t)bits, &value) ==
+                   CY_RSLT_SUCCESS) && matched;
+        matched = (value == (uint32_t)(stream & ((1ull << bits) - 1u))) &&
+                  matched;
+        stream >>= bits;
+        stream_bits -= bits;
+
+        level_ok = (bit_reservoir_level() == stream_bits) && level_ok;
+    }
+
+    CHECK(matched);
+    CHECK(level_ok);
+
+    /* The flushed bits are never handed out */
+    bit_reservoir_flush();
+    CHECK(bit_reservoir_level() == 0u);
+    CHECK(bit_reservoir_take(8u, &value) == CY_RSLT_SUCCESS);
+    CHECK(value == (mock_words[next] & 0xFFu));
+    CHECK(bit_reservoir_level() == 24u);
+}
+
+/*******************************************************************************
+* Function Name: test_entropy_pool
+********************************************************************************
+* Summary:
+* This function fills the entropy pool with refill interrupts and checks that
+* the words are served in the order of the mock sequence, that a drained
+* pool falls back to the TRNG session, and that a health test failure starts
+* the fault recovery, during which the pool reports the recovery at once. The
+* recovery is left running for test_trng_recovery().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_entropy_pool(void)
+{
+    uint32_t next;
+    uint32_t index;
+    uint32_t word;
+    bool matched = true;
+
+    entropy_pool_flush();
+    next = open_session(mock_words, TEST_MOCK_WORDS);
+    CHECK(entropy_pool_available() == 0u);
+
+    /* ENTROPY_POOL_REFILL_BURST words per refill interrupt */
+    tick_ms((ENTROPY_POOL_SIZE_WORDS / ENTROPY_POOL_REFILL_BURST) + 2u);
+
+    CHECK(entropy_pool_is_full());
+    CHECK(entropy_pool_available() == ENTROPY_POOL_SIZE_WORDS);
+
+    /* The pool words, then one straight from the session */
+    for (index = 0; index < (ENTROPY_POOL_SIZE_WORDS + 1u); index++)
+    {
+        matched = (entropy_pool_get(&word) == CY_RSLT_SUCCESS) && matched;
+        matched = (word == mock_words[next]) && matched;
+        next = (next + 1u) % TEST_MOCK_WORDS;
+    }
+
+    CHECK(matched);
+    CHECK(entropy_pool_available() == 0u);
+
+    /* A stuck TRNG fails the refill; the main loop starts the recovery */
+    trng_hal_host_set_mock(stuck_words, 1u);
+    tick_ms(1u);
+    CHECK(health_test_get_status() == HEALTH_TEST_RCT_FAILURE);
+    CHECK(entropy_pool_available() < ENTROPY_POOL_SIZE_WORDS);
+    CHECK(entropy_pool_process() == APP_RSLT_ERR_HEALTH_TEST);
+    CHECK(trng_recovery_is_active());
+    CHECK(entropy_pool_available() == 0u);
+    CHECK(entropy_pool_get(&word) == APP_RSLT_ERR_TRNG_RECOVERY);
+}
+
+/*******************************************************************************
+* Function Name: test_trng_recovery
+********************************************************************************
+* Summary:
+* This function runs the recovery started by test_entropy_pool(). No attempt
+* is made before its backoff delay, each attempt resets the crypto block and
+* loads the DRBG key again, a failed attempt doubles the delay, and the
+* session is reopened once the TRNG is good again.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_trng_recovery(void)
+{
+    uint32_t resets = crypto_block_host_get_resets();
+    uint32_t key_loads = drbg_host_get_key_loads();
+
+    CHECK(trng_recovery_get_state() == TRNG_RECOVERY_WAITING);
+
+    tick_ms(TRNG_RECOVERY_BACKOFF_MS - 1u);
+    trng_recovery_process();
+    CHECK(crypto_block_host_get_resets() == resets);
+
+    /* The first attempt fails on the stuck TRNG */
+    tick_ms(1u);
+    trng_recovery_process();
+    CHECK(crypto_block_host_get_resets() == (resets + 1u));
+    CHECK(drbg_host_get_key_loads() == (key_loads + 1u));
+    CHECK(trng_recovery_get_state() == TRNG_RECOVERY_WAITING);
+    CHECK(!trng_session_is_open());
+
+    /* The second attempt waits twice as long and succeeds */
+    trng_hal_host_set_mock(mock_words, TEST_MOCK_WORDS);
+    tick_ms((2u * TRNG_RECOVERY_BACKOFF_MS) - 1u);
+    trng_recovery_process();
+    CHECK(crypto_block_host_get_resets() == (resets + 1u));
+
+    tick_ms(1u);
+    trng_recovery_process();
+    CHECK(crypto_block_host_get_resets() == (resets + 2u));
+    CHECK(drbg_host_get_key_loads() == (key_loads + 2u));
+    CHECK(trng_recovery_get_state() == TRNG_RECOVERY_IDLE);
+    CHECK(trng_recovery_get_count() == 1u);
+    CHECK(trng_session_is_open());
+
+    entropy_pool_flush();
+    tick_ms(1u);
+    CHECK(entropy_pool_available() == ENTROPY_POOL_REFILL_BURST);
+    CHECK(entropy_pool_process() == CY_RSLT_SUCCESS);
+}
+
+/*******************************************************************************
+* Function Name: test_random_source
+********************************************************************************
+* Summary:
+* This function checks that TRNG mode serves the conditioned pool words and
+* fails during a recovery, while password words are taken from the DRBG until
+* its next reseed is due. It then lets every recovery attempt fail, which
+* gives the TRNG up after TRNG_RECOVERY_MAX_ATTEMPTS attempts.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_random_source(void)
+{
+    uint32_t next;
+    uint32_t index;
+    uint32_t word;
+    uint32_t backoff_ms;
+    uint32_t expected_ms = 0;
+    uint32_t elapsed_ms = 0;
+    bool bridged = true;
+
+    /* The conditioner stub passes the pool words on unhashed */
+    CHECK(random_source_select(RANDOM_SOURCE_TRNG) == CY_RSLT_SUCCESS);
+    next = open_session(mock_words, TEST_MOCK_WORDS);
+    CHECK(random_source_word(&word) == CY_RSLT_SUCCESS);
+    CHECK(word == mock_words[next]);
+
+    CHECK(random_source_select(RANDOM_SOURCE_DRBG) == CY_RSLT_SUCCESS);
+    CHECK(random_source_word(&word) == CY_RSLT_SUCCESS);
+    CHECK(random_source_select((random_source_t)2) == APP_RSLT_ERR_BAD_PARAM);
+    CHECK(random_source_get() == RANDOM_SOURCE_DRBG);
+
+    /* Two generate requests are left before the reseed */
+    CHECK(random_source_select(RANDOM_SOURCE_TRNG) == CY_RSLT_SUCCESS);
+    CHECK(drbg_reseed() == CY_RSLT_SUCCESS);
+    drbg_set_reseed_interval(2u);
+
+    trng_hal_host_set_mock(stuck_words, 1u);
+    trng_recovery_start();
+    CHECK(random_source_word(&word) == APP_RSLT_ERR_TRNG_RECOVERY);
+
+    for (index = 0; index < ((2u * RANDOM_SOURCE_DRBG_BUFFER_SIZE) /
+                             sizeof(word)); index++)
+    {
+        bridged = (random_source_password_word(&word) == CY_RSLT_SUCCESS) &&
+                  bridged;
+    }
+
+    CHECK(bridged);
+    CHECK(random_source_password_word(&word) == APP_RSLT_ERR_TRNG_RECOVERY);
+    drbg_set_reseed_interval(DRBG_DEFAULT_RESEED_INTERVAL);
+
+    /* Every attempt fails; the delay doubles up to its maximum */
+    for (index = 0, backoff_ms = TRNG_RECOVERY_BACKOFF_MS;
+         index < TRNG_RECOVERY_MAX_ATTEMPTS; index++)
+    {
+        expected_ms += backoff_ms;
+        backoff_ms = ((2u * backoff_ms) > TRNG_RECOVERY_MAX_BACKOFF_MS) ?
+                     TRNG_RECOVERY_MAX_BACKOFF_MS : (2u * backoff_ms);
+    }
+
+    while ((trng_recovery_get_state() == TRNG_RECOVERY_WAITING) &&
+           (elapsed_ms <= expected_ms))
+    {
+        tick_ms(1u);
+        elapsed_ms++;
+        trng_recovery_process();
+    }
+
+    CHECK(trng_recovery_get_state() == TRNG_RECOVERY_FAILED);
+    CHECK(elapsed_ms == expected_ms);
+    CHECK(!trng_session_is_open());
+    CHECK(random_source_word(&word) == APP_RSLT_ERR_TRNG_RECOVERY);
+}
+
+#endif /* TRNG_HAL_HOST */
+
+/* [] END OF FILE */
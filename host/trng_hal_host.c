@@ -0,0 +1,287 @@
+/******************************************************************************
+* File Name:   trng_hal_host.c
+*
+* Description: This file contains the host backend of the TRNG hardware shim.
+* The TRNG words are read from /dev/urandom, or replayed from a mock sequence
+* set by the host program, for example a stuck value to exercise the health
+* tests. TRNG faults are injected by failing the next power-up requests.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#if defined(TRNG_HAL_HOST)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "trng_hal.h"
+#include "trng_hal_host.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Words read from the device at a time */
+#define TRNG_HAL_HOST_BUFFER_WORDS      (256u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static FILE *device = NULL;
+static bool powered = false;
+
+/* Words read from the device and not handed out yet */
+static uint32_t device_words[TRNG_HAL_HOST_BUFFER_WORDS];
+static uint32_t device_index = TRNG_HAL_HOST_BUFFER_WORDS;
+
+/* Mock sequence, replayed from the start once used up */
+static const uint32_t *mock_words = NULL;
+static uint32_t mock_count = 0;
+static uint32_t mock_index = 0;
+
+/* Power-up requests left to fail */
+static uint32_t init_failures = 0;
+
+/* Words generated since the start of the program */
+static uint32_t generated_words = 0;
+
+/*******************************************************************************
+* Function Name: trng_hal_init
+********************************************************************************
+* Summary:
+* This function opens TRNG_HAL_HOST_DEVICE on the first call. It fails while
+* faults injected with trng_hal_host_fail_init() are pending.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_hal_init(void)
+{
+    if (init_failures > 0u)
+    {
+        init_failures--;
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    if (device == NULL)
+    {
+        device = fopen(TRNG_HAL_HOST_DEVICE, "rb");
+
+        if (device == NULL)
+        {
+            return APP_RSLT_ERR_NOT_READY;
+        }
+    }
+
+    powered = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_free
+********************************************************************************
+* Summary:
+* This function marks the TRNG powered down. The device stays open.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_hal_free(void)
+{
+    powered = false;
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_generate
+********************************************************************************
+* Summary:
+* This function returns the next word of the mock sequence, or of the device
+* if no sequence is set. It must only be called while the TRNG is powered up.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t trng_hal_generate(void)
+{
+    uint32_t word;
+
+    CY_ASSERT(powered);
+
+    if (mock_count > 0u)
+    {
+        word = mock_words[mock_index];
+        mock_index = (mock_index + 1u) % mock_count;
+    }
+    else
+    {
+        if (device_index >= TRNG_HAL_HOST_BUFFER_WORDS)
+        {
+            if (fread(device_words, sizeof(device_words), 1u, device) != 1u)
+            {
+                perror(TRNG_HAL_HOST_DEVICE);
+                exit(EXIT_FAILURE);
+            }
+
+            device_index = 0;
+        }
+
+        word = device_words[device_index++];
+    }
+
+    generated_words++;
+
+    return word;
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_configure
+********************************************************************************
+* Summary:
+* This function accepts any tuned configuration. The oscillators have no
+* meaning on the host.
+*
+* Parameters:
+*  config: Configuration to program
+*  von_neumann: Enable the von Neumann corrector, false for raw samples
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_hal_configure(const trng_session_config_t *config,
+                             bool von_neumann)
+{
+    CY_UNUSED_PARAMETER(von_neumann);
+
+    return ((config->bit_count > 0u) &&
+            (config->bit_count <= TRNG_SESSION_MAX_BIT_COUNT)) ?
+           CY_RSLT_SUCCESS : APP_RSLT_ERR_BAD_PARAM;
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_read_bits
+********************************************************************************
+* Summary:
+* This function returns the low bits of the next word.
+*
+* Parameters:
+*  bits: Bits of the run, 1 to 32
+*  sample: Location to store the bits, in the low bits of the word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_hal_read_bits(uint8_t bits, uint32_t *sample)
+{
+    *sample = (uint32_t)(trng_hal_generate() & ((1ull << bits) - 1u));
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_host_set_mock
+********************************************************************************
+* Summary:
+* This function replaces the device output by a sequence of words, which is
+* replayed from the start once used up.
+*
+* Parameters:
+*  words: Sequence, unchanged while it is set
+*  count: Number of words, 0 to return to the device output
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_hal_host_set_mock(const uint32_t *words, uint32_t count)
+{
+    mock_words = words;
+    mock_count = (words != NULL) ? count : 0u;
+    mock_index = 0;
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_host_fail_init
+********************************************************************************
+* Summary:
+* This function makes the next power-up requests fail, like a TRNG fault.
+*
+* Parameters:
+*  count: Number of requests to fail
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_hal_host_fail_init(uint32_t count)
+{
+    init_failures = count;
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_host_get_words
+********************************************************************************
+* Summary:
+* This function returns the number of words generated so far.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t trng_hal_host_get_words(void)
+{
+    return generated_words;
+}
+
+#endif /* TRNG_HAL_HOST */
+
+/* [] END OF FILE */
@@ -0,0 +1,494 @@
+/******************************************************************************
+* File Name:   hotp.c
+*
+* Description: This file contains the HOTP (RFC 4226) and TOTP (RFC 6238)
+* engine. The shared secret is drawn once from the conditioned TRNG output,
+* and the codes are computed with the HMAC of the crypto block. The time comes
+* from the RTC, and the TOTP code of the current time step is cached, so
+* requests within the same step need no HMAC.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include <time.h>
+#include "cy_pdl.h"
+#include "hotp.h"
+#include "crypto_block.h"
+#include "conditioner.h"
+#include "alphabet.h"
+#include "zeroize.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Moving factor: 8-byte big-endian counter */
+#define HOTP_COUNTER_SIZE               (8u)
+
+#if (HOTP_DIGITS < 6u) || (HOTP_DIGITS > 9u)
+#error "HOTP_DIGITS must be 6 to 9"
+#endif
+
+#define SECONDS_PER_DAY                 (86400u)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static cy_rslt_t compute_code(uint64_t counter, uint32_t *code);
+static void invalidate_totp(void);
+static uint32_t rtc_to_unix(const struct tm *date_time);
+static uint32_t days_from_civil(uint32_t year, uint32_t month, uint32_t day);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* 10^digits */
+static const uint32_t digit_modulus[] =
+{
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u,
+    1000000000u
+};
+
+static CRYPTO_Type *crypto_base = NULL;
+static cyhal_rtc_t rtc_obj;
+
+static uint8_t hotp_secret[HOTP_SECRET_SIZE];
+static bool secret_valid = false;
+
+/* Counter of the next HOTP code */
+static uint64_t hotp_counter = 0;
+
+static bool time_set = false;
+
+/* TOTP code of the last time step computed */
+static bool totp_cached = false;
+static uint64_t cached_step;
+static uint32_t cached_code;
+
+/* HMAC input and output, wiped after every code */
+static uint8_t hmac_message[HOTP_COUNTER_SIZE];
+static uint8_t hmac_digest[HOTP_DIGEST_SIZE];
+
+/*******************************************************************************
+* Function Name: hotp_init
+********************************************************************************
+* Summary:
+* This function reserves the crypto block for the HMAC and initializes the
+* RTC. No secret exists until hotp_new_secret() is called.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t hotp_init(void)
+{
+    cy_rslt_t result = crypto_block_reserve(&crypto_base);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_rtc_init(&rtc_obj);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: hotp_new_secret
+********************************************************************************
+* Summary:
+* This function replaces the shared secret with HOTP_SECRET_SIZE bytes of
+* conditioned TRNG output, independent of the selected random source. The
+* HOTP counter restarts at 0.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t hotp_new_secret(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t word = 0;
+    uint32_t offset;
+
+    secret_valid = false;
+    invalidate_totp();
+
+    for (offset = 0; (offset < HOTP_SECRET_SIZE) &&
+                     (result == CY_RSLT_SUCCESS); offset += sizeof(word))
+    {
+        result = conditioner_get(&word);
+        memcpy(&hotp_secret[offset], &word, sizeof(word));
+    }
+
+    zeroize(&word, sizeof(word));
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        hotp_counter = 0;
+        secret_valid = true;
+    }
+    else
+    {
+        zeroize(hotp_secret, sizeof(hotp_secret));
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: hotp_has_secret
+********************************************************************************
+* Summary:
+* This function returns whether a shared secret has been generated.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool hotp_has_secret(void)
+{
+    return secret_valid;
+}
+
+/*******************************************************************************
+* Function Name: hotp_secret_base32
+********************************************************************************
+* Summary:
+* This function writes the shared secret in RFC 4648 base32 without padding,
+* the format authenticator apps expect for enrollment.
+*
+* Parameters:
+*  text: Buffer of HOTP_SECRET_BASE32_LENGTH + 1 characters, NULL terminated
+*        on return
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void hotp_secret_base32(char *text)
+{
+    static const alphabet_step_t steps[ALPHABET_MAX_STEPS] =
+        ALPHABET_BASE32_STEPS;
+    uint32_t buffer = 0;
+    uint32_t bits = 0;
+    uint32_t index;
+
+    for (index = 0; index < HOTP_SECRET_SIZE; index++)
+    {
+        buffer = (buffer << 8u) | hotp_secret[index];
+        bits += 8u;
+
+        while (bits >= 5u)
+        {
+            bits -= 5u;
+            *text++ = (char)alphabet_char(ALPHABET_BASE32_FIRST, steps,
+                                         (buffer >> bits) & 0x1Fu);
+        }
+    }
+
+    if (bits > 0u)
+    {
+        *text++ = (char)alphabet_char(ALPHABET_BASE32_FIRST, steps,
+                                     (buffer << (5u - bits)) & 0x1Fu);
+    }
+
+    *text = '\0';
+    zeroize(&buffer, sizeof(buffer));
+}
+
+/*******************************************************************************
+* Function Name: hotp_next
+********************************************************************************
+* Summary:
+* This function computes the HOTP code of the current counter and advances
+* the counter.
+*
+* Parameters:
+*  code: HOTP_DIGITS digit code
+*  counter: Counter the code belongs to
+*
+* Return:
+*  cy_rslt_t: APP_RSLT_ERR_NOT_READY if no secret exists
+*
+*******************************************************************************/
+cy_rslt_t hotp_next(uint32_t *code, uint64_t *counter)
+{
+    cy_rslt_t result = compute_code(hotp_counter, code);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        *counter = hotp_counter;
+        hotp_counter++;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: totp_set_time
+********************************************************************************
+* Summary:
+* This function sets the RTC to a UTC time.
+*
+* Parameters:
+*  unix_time: Seconds since 1970-01-01 00:00:00 UTC
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t totp_set_time(uint32_t unix_time)
+{
+    time_t seconds = (time_t)unix_time;
+    struct tm date_time;
+    cy_rslt_t result;
+
+    (void)gmtime_r(&seconds, &date_time);
+
+    result = cyhal_rtc_write(&rtc_obj, &date_time);
+
+    time_set = (result == CY_RSLT_SUCCESS);
+    invalidate_totp();
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: totp_now
+********************************************************************************
+* Summary:
+* This function returns the TOTP code of the current time step. The HMAC runs
+* only for the first request of a time step; later requests in the same step
+* return the cached code.
+*
+* Parameters:
+*  code: HOTP_DIGITS digit code
+*  remaining: Seconds until the code changes
+*
+* Return:
+*  cy_rslt_t: APP_RSLT_ERR_NOT_READY if no secret exists or the time is not
+*             set
+*
+*******************************************************************************/
+cy_rslt_t totp_now(uint32_t *code, uint32_t *remaining)
+{
+    struct tm date_time;
+    cy_rslt_t result;
+    uint32_t seconds;
+    uint64_t step;
+
+    if (!time_set || !secret_valid)
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    result = cyhal_rtc_read(&rtc_obj, &date_time);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        seconds = rtc_to_unix(&date_time) - TOTP_T0;
+        step = seconds / TOTP_STEP_SECONDS;
+        *remaining = TOTP_STEP_SECONDS - (seconds % TOTP_STEP_SECONDS);
+
+        if (!totp_cached || (step != cached_step))
+        {
+            invalidate_totp();
+            result = compute_code(step, &cached_code);
+            cached_step = step;
+            totp_cached = (result == CY_RSLT_SUCCESS);
+        }
+
+        *code = cached_code;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: compute_code
+********************************************************************************
+* Summary:
+* This function computes HOTP(K, C): the HMAC of the big-endian counter with
+* the shared secret, dynamically truncated to HOTP_DIGITS digits (RFC 4226
+* section 5.3).
+*
+* Parameters:
+*  counter: Moving factor, the HOTP counter or the TOTP time step
+*  code: HOTP_DIGITS digit code
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t compute_code(uint64_t counter, uint32_t *code)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t saved_intr_status;
+    uint32_t offset;
+    uint32_t index;
+
+    if (!secret_valid || (crypto_base == NULL))
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    for (index = 0; index < HOTP_COUNTER_SIZE; index++)
+    {
+        hmac_message[index] = (uint8_t)(counter >>
+                              (8u * (HOTP_COUNTER_SIZE - 1u - index)));
+    }
+
+    /* Keep the refill interrupt off the crypto block during the HMAC */
+    saved_intr_status = cyhal_system_critical_section_enter();
+    if (Cy_Crypto_Core_Hmac(crypto_base, hmac_digest, hmac_message,
+                            HOTP_COUNTER_SIZE, hotp_secret, HOTP_SECRET_SIZE,
+                            HOTP_HMAC_MODE) != CY_CRYPTO_SUCCESS)
+    {
+        result = APP_RSLT_ERR_CRYPTO;
+    }
+    cyhal_system_critical_section_exit(saved_intr_status);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        /* Dynamic truncation */
+        offset = hmac_digest[HOTP_DIGEST_SIZE - 1u] & 0x0Fu;
+        *code = ((((uint32_t)hmac_digest[offset] & 0x7Fu) << 24u) |
+                 ((uint32_t)hmac_digest[offset + 1u] << 16u) |
+                 ((uint32_t)hmac_digest[offset + 2u] << 8u) |
+                 (uint32_t)hmac_digest[offset + 3u]) %
+                digit_modulus[HOTP_DIGITS];
+    }
+
+    zeroize(hmac_digest, sizeof(hmac_digest));
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: invalidate_totp
+********************************************************************************
+* Summary:
+* This function wipes the cached TOTP code when it is replaced or no longer
+* valid.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void invalidate_totp(void)
+{
+    totp_cached = false;
+    zeroize(&cached_code, sizeof(cached_code));
+}
+
+/*******************************************************************************
+* Function Name: rtc_to_unix
+********************************************************************************
+* Summary:
+* This function converts the UTC date and time read from the RTC into
+* seconds since 1970-01-01 00:00:00 UTC.
+*
+* Parameters:
+*  date_time: Date and time, tm_year counts from 1900 and tm_mon from 0
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+static uint32_t rtc_to_unix(const struct tm *date_time)
+{
+    return (days_from_civil((uint32_t)date_time->tm_year + 1900u,
+                            (uint32_t)date_time->tm_mon + 1u,
+                            (uint32_t)date_time->tm_mday) * SECONDS_PER_DAY) +
+           ((uint32_t)date_time->tm_hour * 3600u) +
+           ((uint32_t)date_time->tm_min * 60u) +
+           (uint32_t)date_time->tm_sec;
+}
+
+/*******************************************************************************
+* Function Name: days_from_civil
+********************************************************************************
+* Summary:
+* This function returns the number of days from 1970-01-01 to a date of the
+* proleptic Gregorian calendar, counting years from March so that the leap
+* day is the last day of the year.
+*
+* Parameters:
+*  year: Year, 1970 or later
+*  month: Month, 1 to 12
+*  day: Day of the month, 1 to 31
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+static uint32_t days_from_civil(uint32_t year, uint32_t month, uint32_t day)
+{
+    uint32_t era;
+    uint32_t year_of_era;
+    uint32_t day_of_year;
+    uint32_t day_of_era;
+
+    if (month <= 2u)
+    {
+        year--;
+    }
+
+    era = year / 400u;
+    year_of_era = year - (era * 400u);
+    day_of_year = (((153u * ((month > 2u) ? (month - 3u) : (month + 9u))) +
+                    2u) / 5u) + day - 1u;
+    day_of_era = (year_of_era * 365u) + (year_of_era / 4u) -
+                 (year_of_era / 100u) + day_of_year;
+
+    /* 719468 days from 0000-03-01 to 1970-01-01 */
+    return (era * 146097u) + day_of_era - 719468u;
+}
+
+/* [] END OF FILE */
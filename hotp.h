@@ -0,0 +1,88 @@
+/******************************************************************************
+* File Name:   hotp.h
+*
+* Description: This file contains the interface of the HOTP (RFC 4226) and
+* TOTP (RFC 6238) engine of the HAL: MCU Cryptography: True Random Number
+* Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef HOTP_H
+#define HOTP_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* HMAC-SHA1 by default, as used by most authenticator apps. Define
+   HOTP_HMAC_SHA256 in the Makefile DEFINES for HMAC-SHA256 */
+#if defined(HOTP_HMAC_SHA256)
+#define HOTP_HMAC_MODE                  (CY_CRYPTO_MODE_SHA256)
+#define HOTP_DIGEST_SIZE                (32u)
+#else
+#define HOTP_HMAC_MODE                  (CY_CRYPTO_MODE_SHA1)
+#define HOTP_DIGEST_SIZE                (20u)
+#endif
+
+/* Shared secret, as long as the HMAC output (RFC 4226 section 4 R6) */
+#define HOTP_SECRET_SIZE                (HOTP_DIGEST_SIZE)
+
+/* Base32 characters of the secret, without padding */
+#define HOTP_SECRET_BASE32_LENGTH       (((HOTP_SECRET_SIZE * 8u) + 4u) / 5u)
+
+/* Digits of a code */
+#define HOTP_DIGITS                     (6u)
+
+/* TOTP time step X and start time T0 in seconds (RFC 6238 section 4) */
+#define TOTP_STEP_SECONDS               (30u)
+#define TOTP_T0                         (0u)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t hotp_init(void);
+cy_rslt_t hotp_new_secret(void);
+bool hotp_has_secret(void);
+void hotp_secret_base32(char *text);
+cy_rslt_t hotp_next(uint32_t *code, uint64_t *counter);
+cy_rslt_t totp_set_time(uint32_t unix_time);
+cy_rslt_t totp_now(uint32_t *code, uint32_t *remaining);
+
+#endif /* HOTP_H */
+
+/* [] END OF FILE */
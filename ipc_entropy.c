@@ -0,0 +1,250 @@
+/******************************************************************************
+* File Name:   ipc_entropy.c
+*
+* Description: This file contains both sides of the dual-core entropy
+* transport. The CM4 places the ring buffer in its SRAM and hands its address
+* to the CM0+ through an IPC channel. The CM0+ then fills the ring with
+* health-tested TRNG words and sleeps in WFE while it is full; the CM4 wakes
+* it with SEV after taking words. The indices are free-running, so no lock is
+* needed between the cores.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "ipc_entropy.h"
+#include "trng_hal.h"
+#include "health_test.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define IPC_ENTROPY_INDEX_MASK          (IPC_ENTROPY_RING_WORDS - 1u)
+
+#if ((IPC_ENTROPY_RING_WORDS & IPC_ENTROPY_INDEX_MASK) != 0u)
+#error "IPC_ENTROPY_RING_WORDS must be a power of two"
+#endif
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Ring buffer in CM4 SRAM, shared with the CM0+ */
+static ipc_entropy_ring_t entropy_ring;
+
+/*******************************************************************************
+* Function Name: ipc_entropy_init
+********************************************************************************
+* Summary:
+* CM4 side. This function clears the ring buffer and sends its address to the
+* CM0+ through IPC_ENTROPY_CHANNEL. The CM0+ picks it up when its producer
+* starts.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t ipc_entropy_init(void)
+{
+    IPC_STRUCT_Type *ipc_base =
+        Cy_IPC_Drv_GetIpcBaseAddress(IPC_ENTROPY_CHANNEL);
+
+    entropy_ring.head = 0;
+    entropy_ring.tail = 0;
+    entropy_ring.status = IPC_ENTROPY_STATUS_WAITING;
+    __DMB();
+
+    return (Cy_IPC_Drv_SendMsgPtr(ipc_base, CY_IPC_NO_NOTIFICATION,
+                                  &entropy_ring) == CY_IPC_DRV_SUCCESS) ?
+           CY_RSLT_SUCCESS : APP_RSLT_ERR_NOT_READY;
+}
+
+/*******************************************************************************
+* Function Name: ipc_entropy_get
+********************************************************************************
+* Summary:
+* CM4 side. This function takes one TRNG word from the ring buffer. If the
+* ring is empty, it waits for up to IPC_ENTROPY_WAIT_LOOPS polls.
+*
+* Parameters:
+*  value: Location to store the word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t ipc_entropy_get(uint32_t *value)
+{
+    uint32_t tail = entropy_ring.tail;
+    uint32_t loops = 0;
+
+    while ((entropy_ring.head == tail) && (loops < IPC_ENTROPY_WAIT_LOOPS))
+    {
+        if (entropy_ring.status == IPC_ENTROPY_STATUS_HEALTH_FAILURE)
+        {
+            return APP_RSLT_ERR_HEALTH_TEST;
+        }
+
+        loops++;
+    }
+
+    if (entropy_ring.head == tail)
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    /* Make sure the word is read after the head index that published it */
+    __DMB();
+    *value = entropy_ring.words[tail & IPC_ENTROPY_INDEX_MASK];
+    entropy_ring.words[tail & IPC_ENTROPY_INDEX_MASK] = 0;
+    __DMB();
+    entropy_ring.tail = tail + 1u;
+
+    /* Wake the CM0+ if it waits for free space */
+    __SEV();
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: ipc_entropy_get_status
+********************************************************************************
+* Summary:
+* CM4 side. This function returns the state reported by the CM0+ producer.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  ipc_entropy_status_t
+*
+*******************************************************************************/
+ipc_entropy_status_t ipc_entropy_get_status(void)
+{
+    return (ipc_entropy_status_t)entropy_ring.status;
+}
+
+/*******************************************************************************
+* Function Name: ipc_entropy_producer_run
+********************************************************************************
+* Summary:
+* CM0+ side. This function waits for the ring buffer address from the CM4,
+* starts the TRNG and keeps the ring filled. It is called from the main()
+* of the CM0+ application after cybsp_init() and does not return. After a
+* health test failure, no further word is published.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_entropy_producer_run(void)
+{
+    IPC_STRUCT_Type *ipc_base =
+        Cy_IPC_Drv_GetIpcBaseAddress(IPC_ENTROPY_CHANNEL);
+    ipc_entropy_ring_t *ring = NULL;
+    uint32_t head;
+    uint32_t word;
+    uint32_t count;
+    bool healthy = true;
+
+    /* The message is valid once the CM4 holds the channel lock */
+    while (Cy_IPC_Drv_ReadMsgPtr(ipc_base, (void **)&ring) !=
+           CY_IPC_DRV_SUCCESS)
+    {
+        /* Wait for the CM4 */
+    }
+    (void)Cy_IPC_Drv_LockRelease(ipc_base, CY_IPC_NO_NOTIFICATION);
+
+    if (trng_hal_init() != CY_RSLT_SUCCESS)
+    {
+        ring->status = IPC_ENTROPY_STATUS_TRNG_ERROR;
+        healthy = false;
+    }
+    else
+    {
+        /* Startup test on words that are not published */
+        health_test_clear();
+        for (count = 0; (count < HEALTH_TEST_STARTUP_WORDS) && healthy;
+             count++)
+        {
+            healthy = health_test_feed(trng_hal_generate());
+        }
+
+        ring->status = healthy ? IPC_ENTROPY_STATUS_RUNNING :
+                                 IPC_ENTROPY_STATUS_HEALTH_FAILURE;
+    }
+
+    while (healthy)
+    {
+        head = ring->head;
+
+        if ((head - ring->tail) >= IPC_ENTROPY_RING_WORDS)
+        {
+            /* Full, sleep until the CM4 takes a word */
+            __WFE();
+            continue;
+        }
+
+        word = trng_hal_generate();
+
+        if (!health_test_feed(word))
+        {
+            ring->status = IPC_ENTROPY_STATUS_HEALTH_FAILURE;
+            healthy = false;
+        }
+        else
+        {
+            ring->words[head & IPC_ENTROPY_INDEX_MASK] = word;
+
+            /* Publish the word only after it is stored */
+            __DMB();
+            ring->head = head + 1u;
+        }
+    }
+
+    for (;;)
+    {
+        __WFE();
+    }
+}
+
+/* [] END OF FILE */
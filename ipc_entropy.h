@@ -0,0 +1,98 @@
+/******************************************************************************
+* File Name:   ipc_entropy.h
+*
+* Description: This file contains the interface of the dual-core entropy
+* transport of the HAL: MCU Cryptography: True Random Number Generation
+* Example. The CM0+ owns the TRNG and fills a ring buffer in shared memory
+* that the CM4 consumes.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_ENTROPY_H
+#define IPC_ENTROPY_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* IPC channel used to hand the ring buffer address to the CM0+ */
+#ifndef IPC_ENTROPY_CHANNEL
+#define IPC_ENTROPY_CHANNEL             (CY_IPC_CHAN_USER)
+#endif
+
+/* Words held by the shared ring buffer. Must be a power of two */
+#define IPC_ENTROPY_RING_WORDS          (256u)
+
+/* Polls of an empty ring before ipc_entropy_get() gives up */
+#define IPC_ENTROPY_WAIT_LOOPS          (100000u)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+typedef enum
+{
+    IPC_ENTROPY_STATUS_WAITING,         /* CM0+ has not attached yet */
+    IPC_ENTROPY_STATUS_RUNNING,         /* CM0+ is harvesting */
+    IPC_ENTROPY_STATUS_TRNG_ERROR,      /* CM0+ could not start the TRNG */
+    IPC_ENTROPY_STATUS_HEALTH_FAILURE   /* CM0+ health tests failed */
+} ipc_entropy_status_t;
+
+/* Shared ring buffer. head is written only by the CM0+, tail and the
+   words already read only by the CM4 */
+typedef struct
+{
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile uint32_t status;           /* ipc_entropy_status_t */
+    uint32_t words[IPC_ENTROPY_RING_WORDS];
+} ipc_entropy_ring_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+/* CM4 consumer */
+cy_rslt_t ipc_entropy_init(void);
+cy_rslt_t ipc_entropy_get(uint32_t *value);
+ipc_entropy_status_t ipc_entropy_get_status(void);
+
+/* CM0+ producer */
+void ipc_entropy_producer_run(void);
+
+#endif /* IPC_ENTROPY_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,303 @@
+/******************************************************************************
+* File Name:   low_power.c
+*
+* Description: This file contains the duty-cycled low-power mode. The TRNG
+* runs only until the entropy pool, which stays in retained SRAM, is full.
+* Then the TRNG and the crypto block are powered off and the device enters
+* DeepSleep until a falling edge on the UART RX pin wakes it up. The next
+* password is served from the pool without waiting for the TRNG. After a
+* wakeup and after every received character, the device stays awake for
+* LOW_POWER_AWAKE_MS, so the commands that follow the wake character reach
+* the UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "low_power.h"
+#include "trng_session.h"
+#include "entropy_pool.h"
+#include "crypto_block.h"
+#include "drbg.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+#include "otp_queue.h"
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void rx_pin_callback(void *callback_arg, cyhal_gpio_event_t event);
+static void awake_timer_callback(void *callback_arg, cyhal_timer_event_t event);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* UART RX pin used as the DeepSleep wakeup source. Its interrupt is served
+   by the HAL port handler, which other pins of the port can share */
+static cyhal_gpio_t wake_pin = NC;
+static cyhal_gpio_callback_data_t wake_pin_callback_data =
+{
+    .callback = rx_pin_callback,
+    .callback_arg = NULL
+};
+
+/* One-shot timer of the awake window */
+static cyhal_timer_t awake_timer_obj;
+
+/* Set while the awake window runs, cleared by the timer when it ends */
+static volatile bool awake = false;
+
+/*******************************************************************************
+* Function Name: low_power_init
+********************************************************************************
+* Summary:
+* This function registers the wakeup handler of the UART RX pin with the HAL
+* and prepares the awake window timer. The SCB does not receive in DeepSleep,
+* so the start bit of the first character is detected on the pin instead;
+* that character is discarded by low_power_drop_wake_char(). The HAL serves
+* the port interrupt, so other pins of the port keep their own callbacks.
+*
+* Parameters:
+*  rx_pin: UART RX pin
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t low_power_init(cyhal_gpio_t rx_pin)
+{
+    const cyhal_timer_cfg_t awake_timer_cfg =
+    {
+        .compare_value = 0,
+        .period = ((LOW_POWER_AWAKE_MS * LOW_POWER_TIMER_FREQ_HZ) / 1000u) - 1u,
+        .direction = CYHAL_TIMER_DIR_UP,
+        .is_compare = false,
+        .is_continuous = false,
+        .value = 0
+    };
+    cy_rslt_t result;
+
+    result = cyhal_timer_init(&awake_timer_obj, NC, NULL);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_configure(&awake_timer_obj, &awake_timer_cfg);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_set_frequency(&awake_timer_obj,
+                                           LOW_POWER_TIMER_FREQ_HZ);
+    }
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    cyhal_timer_register_callback(&awake_timer_obj, awake_timer_callback,
+                                  NULL);
+    cyhal_timer_enable_event(&awake_timer_obj, CYHAL_TIMER_IRQ_TERMINAL_COUNT,
+                             LOW_POWER_TIMER_INTR_PRIORITY, true);
+
+    /* The pin event is enabled only while in DeepSleep */
+    wake_pin = rx_pin;
+    cyhal_gpio_register_callback(wake_pin, &wake_pin_callback_data);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: low_power_stay_awake
+********************************************************************************
+* Summary:
+* This function restarts the awake window. The main loop calls it whenever
+* characters were received, so DeepSleep is entered only after the console
+* has been idle for LOW_POWER_AWAKE_MS.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void low_power_stay_awake(void)
+{
+    awake = true;
+
+    (void)cyhal_timer_stop(&awake_timer_obj);
+    (void)cyhal_timer_reset(&awake_timer_obj);
+    (void)cyhal_timer_start(&awake_timer_obj);
+}
+
+/*******************************************************************************
+* Function Name: low_power_can_deepsleep
+********************************************************************************
+* Summary:
+* This function returns whether the awake window has ended, the entropy pool
+* and the OTP queue are full, and the UART is idle, so that DeepSleep neither
+* loses the next command nor delays the next password.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool low_power_can_deepsleep(void)
+{
+    return ((wake_pin != NC) && !awake && entropy_pool_is_full() &&
+            otp_queue_is_full() && !uart_tx_busy() && !uart_rx_pending());
+}
+
+/*******************************************************************************
+* Function Name: low_power_deepsleep
+********************************************************************************
+* Summary:
+* This function powers the TRNG and the crypto block off, enters DeepSleep
+* until the UART RX pin or another wakeup source wakes the device up, and
+* powers the crypto block on again. The awake window is started, so the
+* device stays awake for the commands that follow the wake character. The
+* TRNG session is reopened later by entropy_pool_process() once words were
+* taken. Call it with interrupts masked, after low_power_can_deepsleep()
+* returned true, and call low_power_drop_wake_char() once interrupts are
+* unmasked again.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t: Result of cyhal_syspm_deepsleep()
+*
+*******************************************************************************/
+cy_rslt_t low_power_deepsleep(void)
+{
+    cy_rslt_t result;
+
+    trng_session_close();
+    crypto_block_suspend();
+
+    cyhal_gpio_enable_event(wake_pin, CYHAL_GPIO_IRQ_FALL,
+                            LOW_POWER_WAKE_INTR_PRIORITY, true);
+
+    result = cyhal_syspm_deepsleep();
+
+    cyhal_gpio_enable_event(wake_pin, CYHAL_GPIO_IRQ_FALL,
+                            LOW_POWER_WAKE_INTR_PRIORITY, false);
+
+    crypto_block_resume();
+    (void)drbg_reload_key();
+
+    low_power_stay_awake();
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: low_power_drop_wake_char
+********************************************************************************
+* Summary:
+* This function discards the character that woke the device up. The SCB is
+* clocked again only after the start bit, so the character is lost or
+* received corrupted; either way, it must not become part of the next command
+* line. It waits LOW_POWER_WAKE_SETTLE_MS for the character to end and then
+* discards everything received so far. Must be called with interrupts
+* enabled, right after low_power_deepsleep().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void low_power_drop_wake_char(void)
+{
+    uint8_t value;
+
+    cyhal_system_delay_ms(LOW_POWER_WAKE_SETTLE_MS);
+
+    while (uart_rx_getc(&value))
+    {
+        /* Discard */
+    }
+}
+
+/*******************************************************************************
+* Function Name: rx_pin_callback
+********************************************************************************
+* Summary:
+* UART RX pin falling edge handler. The HAL clears the interrupt; waking up
+* the CPU is all it is needed for.
+*
+* Parameters:
+*  callback_arg: Not used
+*  event: GPIO event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void rx_pin_callback(void *callback_arg, cyhal_gpio_event_t event)
+{
+    CY_UNUSED_PARAMETER(callback_arg);
+    CY_UNUSED_PARAMETER(event);
+}
+
+/*******************************************************************************
+* Function Name: awake_timer_callback
+********************************************************************************
+* Summary:
+* Awake window timer terminal count handler. Ends the awake window.
+*
+* Parameters:
+*  callback_arg: Not used
+*  event: Timer event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void awake_timer_callback(void *callback_arg, cyhal_timer_event_t event)
+{
+    CY_UNUSED_PARAMETER(callback_arg);
+    CY_UNUSED_PARAMETER(event);
+
+    awake = false;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,78 @@
+/******************************************************************************
+* File Name:   low_power.h
+*
+* Description: This file contains the interface of the duty-cycled low-power
+* mode of the HAL: MCU Cryptography: True Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LOW_POWER_H
+#define LOW_POWER_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Interrupt priority of the UART RX pin wakeup */
+#define LOW_POWER_WAKE_INTR_PRIORITY    (7u)
+
+/* Time the device stays awake after a wakeup or a received character */
+#define LOW_POWER_AWAKE_MS              (5000u)
+
+/* Frequency of the timer used to track the awake window */
+#define LOW_POWER_TIMER_FREQ_HZ         (10000u)
+
+/* Interrupt priority of the awake window timer */
+#define LOW_POWER_TIMER_INTR_PRIORITY   (7u)
+
+/* Time given to the wake character to end before it is discarded. Longer
+   than one character at 9600 baud */
+#define LOW_POWER_WAKE_SETTLE_MS        (2u)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t low_power_init(cyhal_gpio_t rx_pin);
+void low_power_stay_awake(void);
+bool low_power_can_deepsleep(void);
+cy_rslt_t low_power_deepsleep(void);
+void low_power_drop_wake_char(void);
+
+#endif /* LOW_POWER_H */
+
+/* [] END OF FILE */
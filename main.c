@@ -40,20 +40,85 @@
 * so agrees to indemnify Cypress against all liability.
 *******************************************************************************/
 
+#include <string.h>
 #include "cyhal.h"
 #include "cybsp.h"  
 #include "cy_retarget_io.h"
+#include "trng_session.h"
+#include "trng_recovery.h"
+#include "entropy_pool.h"
+#include "alphabet.h"
+#include "command.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+#include "trng_fill.h"
+#include "frame.h"
+#include "random_source.h"
+#include "drbg.h"
+#include "health_test.h"
+#include "conditioner.h"
+#include "benchmark.h"
+#include "trng_stats.h"
+#include "entropy_service.h"
+#include "ipc_entropy.h"
+#include "low_power.h"
+#include "otp_queue.h"
+#include "stream.h"
+#include "raw_capture.h"
+#include "hotp.h"
+#include "zeroize.h"
+#include "usb_cdc.h"
+#include "app_result.h"
+
+#if defined(COMPONENT_FREERTOS)
+#include "task.h"
+#endif
            
 /*******************************************************************************
 * Macros
 ********************************************************************************/
-/* Macro for the maximum value of the random number generated in bits */
-#define ASCII_7BIT_MASK                 (0x7F)
-
-#define PASSWORD_LENGTH                 (8u)
-#define ASCII_VISIBLE_CHARACTER_START   (33u)
 #define ASCII_RETURN_CARRIAGE           (0x0D)
 
+#if defined(COMPONENT_FREERTOS)
+/* Console task. It runs below the harvester task of the entropy service */
+#define CONSOLE_TASK_PRIORITY           (tskIDLE_PRIORITY + 1u)
+#define CONSOLE_TASK_STACK_SIZE         (configMINIMAL_STACK_SIZE * 2u)
+
+/* Period at which the console task checks for received characters */
+#define CONSOLE_POLL_MS                 (10u)
+#endif
+
+/* Password settings used after reset */
+/* The defaults are the settings of the specialized OTP queue generator */
+#define PASSWORD_DEFAULT_LENGTH         (OTP_FIXED_LENGTH)
+#define PASSWORD_DEFAULT_ALPHABET       (ALPHABET_ID(OTP_FIXED_ALPHABET))
+#define PASSWORD_DEFAULT_COUNT          (1u)
+
+/* Longest password that can be configured with the L<length> command */
+#define PASSWORD_MAX_LENGTH             (64u)
+
+/* Largest number of passwords generated by one batch command */
+#define BATCH_MAX_COUNT                 (100000u)
+
+/* The DeepSleep mode is driven by the bare-metal main loop and needs the
+   TRNG on the CM4. The USBFS block does not keep the bus alive in DeepSleep */
+#if !defined(COMPONENT_FREERTOS) && !defined(ENTROPY_IPC_ENABLE) && \
+    !defined(USB_CDC_ENABLE)
+#define LOW_POWER_AVAILABLE
+#endif
+
+/* Largest sample clock divider accepted by the K<divider> command */
+#define TRNG_MAX_SAMPLE_CLOCK_DIV       (255u)
+
+/* Baud rate used in binary mode. Set it to the highest rate that the USB-UART
+   bridge of the kit supports reliably */
+#define BINARY_MODE_BAUDRATE            (921600u)
+
+/* Every configurable length must fit into a queued OTP record */
+#if (PASSWORD_MAX_LENGTH > OTP_QUEUE_MAX_LENGTH)
+#error "PASSWORD_MAX_LENGTH exceeds OTP_QUEUE_MAX_LENGTH"
+#endif
+
 #define SCREEN_HEADER "\r\n__________________________________________________"\
            "____________________________\r\n*\tHAL: MCU Cryptography: "\
            "True Random Number Generation\r\n*\r\n*\tThis code example "\
@@ -70,11 +135,71 @@
 /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
 #define CLEAR_SCREEN         "\x1b[2J\x1b[;H"
 
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+/* Password settings that can be changed over the UART */
+typedef struct
+{
+    uint32_t length;
+    alphabet_id_t alphabet;
+    uint32_t count;         /* Passwords generated per Enter key press */
+} password_settings_t;
+
+#if defined(COMPONENT_FREERTOS)
+/* Command line handed to the harvester task */
+typedef struct
+{
+    uart_tx_channel_t channel;
+    const uint8_t *line;
+    uint32_t length;
+} command_job_t;
+#endif
+
+/* Framing of the UART output */
+typedef enum
+{
+    OUTPUT_MODE_TEXT,       /* Human-readable text at CY_RETARGET_IO_BAUDRATE */
+    OUTPUT_MODE_BINARY      /* Binary frames at BINARY_MODE_BAUDRATE */
+} output_mode_t;
+
+/* Command line and output mode of one console channel */
+typedef struct
+{
+    uint8_t line[COMMAND_LINE_SIZE];
+    uint32_t length;
+    bool overflow;
+    output_mode_t output_mode;
+} console_t;
+
 /*******************************************************************************
 * Function Prototypes
 ********************************************************************************/
 void generate_password();
-uint8_t check_range(uint8_t value);
+void generate_password_batch(uint32_t count);
+void process_command(const uint8_t *line, uint32_t length);
+cy_rslt_t write_otp_record(const alphabet_t *alphabet, uint32_t length);
+void print_settings(void);
+void process_binary_command(const command_t *command);
+void set_output_mode(output_mode_t mode);
+void export_random_frames(uint32_t length);
+void capture_raw_noise(uint32_t words);
+void process_otp_command(const command_t *command);
+void configure_trng(const command_t *command);
+void report_generation_error(void);
+void poll_console(void);
+bool poll_channel(uart_tx_channel_t channel);
+bool console_getc(uart_tx_channel_t channel, uint8_t *value);
+bool console_rx_pending(void);
+void execute_command_line(uart_tx_channel_t channel, const uint8_t *line,
+                          uint32_t length);
+#if defined(COMPONENT_FREERTOS)
+void console_task(void *arg);
+void run_command_job(void *arg);
+void refill_otp_job(void *arg);
+void stream_job(void *arg);
+#endif
+void update_otp_queue(void);
 
 /*******************************************************************************
 * Global Variables
@@ -86,6 +211,32 @@ extern cyhal_uart_t cy_retarget_io_uart_obj;
 /* Variable for storing character read from terminal */
 uint8_t uart_read_value;
 
+/* Command lines received from the terminals, one per channel. All channels
+   start in text mode */
+console_t consoles[UART_TX_CHANNEL_COUNT];
+
+/* Current password settings */
+password_settings_t password_settings =
+{
+    .length = PASSWORD_DEFAULT_LENGTH,
+    .alphabet = PASSWORD_DEFAULT_ALPHABET,
+    .count = PASSWORD_DEFAULT_COUNT
+};
+
+/* Set when the DRBG was instantiated successfully */
+bool drbg_available = false;
+
+/* Set by the P1 command: enter DeepSleep whenever the entropy pool is full */
+bool low_power_enabled = false;
+
+/* TRNG configuration edited by the O, K and W commands */
+trng_session_config_t trng_config =
+{
+    .oscillator_mask = TRNG_SESSION_ALL_OSCILLATORS,
+    .sample_clock_div = 0u,
+    .bit_count = TRNG_SESSION_MAX_BIT_COUNT
+};
+
 /*******************************************************************************
 * Function Name: main 
 ********************************************************************************
@@ -104,6 +255,11 @@ uint8_t uart_read_value;
 int main(void)
 {
     cy_rslt_t result;
+    uint32_t saved_intr_status;
+    bool work_pending;
+#if defined(LOW_POWER_AVAILABLE)
+    bool woken;
+#endif
 
     /* Initialize the device and board peripherals */
     result = cybsp_init();
@@ -127,31 +283,249 @@ int main(void)
         CY_ASSERT(0);
     }
 
+    /* Receive commands through the UART RX interrupt */
+    result = uart_rx_init(&cy_retarget_io_uart_obj);
+
+    /* UART receive init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Send generated passwords with asynchronous UART transfers */
+    result = uart_tx_init(&cy_retarget_io_uart_obj);
+
+    /* UART transmit init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+#if defined(USB_CDC_ENABLE)
+    /* Serve the commands on the virtual COM port of the USB CDC device too */
+    result = usb_cdc_init();
+
+    /* USB CDC init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+#endif
+
+#if defined(ENTROPY_IPC_ENABLE)
+    /* The CM0+ owns the TRNG and fills a shared ring buffer. Hand it the
+       address of the ring */
+    result = ipc_entropy_init();
+
+    /* IPC init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+#else
+    /* Bring up the TRNG session used for all password generation */
+    result = trng_session_init();
+
+    /* TRNG session init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Start harvesting TRNG words into the entropy pool in the background */
+    result = entropy_pool_init();
+
+    /* Entropy pool init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Prepare the backoff timer of the TRNG fault recovery */
+    result = trng_recovery_init();
+
+    /* TRNG recovery init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* A TRNG fault at startup is recovered instead of stopping the program */
+    if (trng_session_open() != CY_RSLT_SUCCESS)
+    {
+        trng_recovery_start();
+    }
+#endif
+
+#if defined(LOW_POWER_AVAILABLE)
+    /* Prepare the UART RX pin as the DeepSleep wakeup source */
+    result = low_power_init(CYBSP_DEBUG_UART_RX);
+
+    /* Low power init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+#endif
+
+    /* Get the crypto block for the SHA-256 conditioning of the TRNG words */
+    result = conditioner_init();
+
+    /* Conditioner init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Get the crypto block for the HMAC and the RTC for the TOTP time */
+    result = hotp_init();
+
+    /* HOTP/TOTP init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Instantiate the DRBG from the TRNG. Without it, only the TRNG source
+       is available */
+    drbg_available = (drbg_init() == CY_RSLT_SUCCESS);
+
+    /* Keep pre-generated passwords ready for constant-latency responses */
+    update_otp_queue();
+
+#if defined(TRNG_STATS_ENABLE)
+    trng_stats_init();
+#endif
+
     /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
-    printf(CLEAR_SCREEN);
+    uart_tx_puts(CLEAR_SCREEN);
+
+    uart_tx_puts(SCREEN_HEADER);
+
+#if defined(BENCHMARK_ENABLE) && !defined(ENTROPY_IPC_ENABLE)
+    /* Benchmark build: measure all TRNG paths once before the command loop */
+    benchmark_run();
+#endif
+
+    uart_tx_puts("Press the Enter key to generate password\r\n");
+    uart_tx_puts("Enter B<count> to generate a batch of passwords\r\n");
+    uart_tx_puts("Enter L<length>, A<alphabet> or C<count> to change the "
+                 "settings, ? to show them\r\n");
+    uart_tx_puts("Enter D0 for TRNG or D1 for DRBG output, I<n> to set the "
+                 "DRBG reseed interval\r\n");
+#if !defined(ENTROPY_IPC_ENABLE)
+    uart_tx_puts("Enter O<mask>, K<divider> or W<bits> to tune the TRNG, O0 "
+                 "for the HAL defaults\r\n");
+#endif
+    uart_tx_puts("Enter E to enroll an HOTP/TOTP secret, H for the HOTP "
+                 "code, T for the TOTP code, T<seconds> to set the time\r\n");
+#if defined(LOW_POWER_AVAILABLE)
+    uart_tx_puts("Enter P1 to enter DeepSleep while idle, P0 to stay "
+                 "awake\r\n");
+#endif
+#if defined(TRNG_STATS_ENABLE)
+    uart_tx_puts("Enter S to show the statistics\r\n");
+#endif
+    uart_tx_puts("Enter M1 for binary mode: X<bytes> to export, R<credits> "
+                 "to stream, R0 to stop,\r\n");
+#if !defined(ENTROPY_IPC_ENABLE)
+    uart_tx_puts("  N<words> to capture raw noise, M0 to return to text "
+                 "mode\r\n");
+#else
+    uart_tx_puts("  M0 to return to text mode\r\n");
+#endif
+    uart_tx_flush();
 
-    printf(SCREEN_HEADER);
+#if defined(COMPONENT_FREERTOS)
+    /* From here on, only the harvester task of the entropy service uses the
+       TRNG and the random source. The console runs in its own task */
+    result = entropy_service_init();
 
-    printf("Press the Enter key to generate password\r\n");
+    /* Entropy service init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    if (xTaskCreate(console_task, "console", CONSOLE_TASK_STACK_SIZE, NULL,
+                    CONSOLE_TASK_PRIORITY, NULL) != pdPASS)
+    {
+        CY_ASSERT(0);
+    }
+
+    vTaskStartScheduler();
+
+    /* The scheduler only returns if it could not start */
+    CY_ASSERT(0);
+#endif
 
     for(;;)
     {
-        /* Check if 'Enter' key was pressed */
-        if (cyhal_uart_getc(&cy_retarget_io_uart_obj, &uart_read_value, 1) == CY_RSLT_SUCCESS)
+#if defined(LOW_POWER_AVAILABLE)
+        /* Stay awake while the console is in use */
+        if (uart_rx_pending())
         {
-            if (uart_read_value == ASCII_RETURN_CARRIAGE)
-            {
-                /* Generate a password of 8 characters in length */
-                generate_password();
-            }
+            low_power_stay_awake();
+        }
+#endif
+        poll_console();
+
+        /* Generate the next queued password, one per loop pass */
+        work_pending = otp_queue_process();
+
+        /* Send the next stream frame while the host has credits left */
+        if (stream_process())
+        {
+            work_pending = true;
+        }
+
+        /* Power down the TRNG block once it has been idle long enough, and
+           bring it up again when the entropy pool needs to be topped up */
+        trng_session_process();
+        trng_recovery_process();
+        (void)entropy_pool_process();
+
+        /* Wipe passwords and keys from the transmit buffers once sent */
+        uart_tx_scrub();
+
+        /* Sleep until the next interrupt. Interrupts are masked while checking
+           for input so that a character arriving in between still wakes the
+           CPU */
+        saved_intr_status = cyhal_system_critical_section_enter();
+#if defined(LOW_POWER_AVAILABLE)
+        woken = false;
+        if (low_power_enabled && low_power_can_deepsleep() &&
+            !stream_is_active())
+        {
+            TRNG_STATS_INC(sleeps);
+            (void)low_power_deepsleep();
+            woken = true;
+        }
+        else
+#endif
+        if (!work_pending && !console_rx_pending())
+        {
+            TRNG_STATS_INC(sleeps);
+            (void)cyhal_syspm_sleep();
         }
+        cyhal_system_critical_section_exit(saved_intr_status);
+
+#if defined(LOW_POWER_AVAILABLE)
+        /* The wake character is lost or corrupted, never a command */
+        if (woken)
+        {
+            low_power_drop_wake_char();
+        }
+#endif
     }
 }
 
 /*******************************************************************************
-* Function Name: generate_password
+* Function Name: poll_console
 ********************************************************************************
-* Summary: This function generates a 8 character long password
+* Summary: This function serves the received characters of all channels. The
+*          channels take turns with one command line each, so a host sending
+*          a long run of commands on one channel does not hold up the other.
 *
 * Parameters:
 *  None
@@ -160,76 +534,1034 @@ int main(void)
 *  void
 *
 *******************************************************************************/
-void generate_password()
+void poll_console(void)
 {
-    int8_t index;
-    uint32_t random_val;
-    uint8_t temp_value = 0;
+    uint32_t channel;
+    bool executed = true;
 
-    /* Array to hold the generated password. Array size is inclusive of
-       string NULL terminating character */
-    uint8_t password[PASSWORD_LENGTH + 1]= {0};
-    cy_rslt_t result;
+    while (executed)
+    {
+        executed = false;
 
-    cyhal_trng_t trng_obj;
+        for (channel = 0; channel < (uint32_t)UART_TX_CHANNEL_COUNT; channel++)
+        {
+            executed = poll_channel((uart_tx_channel_t)channel) || executed;
+        }
+    }
+}
 
-    /* Initialize the TRNG generator block*/
-    result = cyhal_trng_init(&trng_obj);
+/*******************************************************************************
+* Function Name: poll_channel
+********************************************************************************
+* Summary: This function collects the received characters of a channel into
+*          its command line and executes the line when the 'Enter' key is
+*          pressed.
+*
+* Parameters:
+*  channel: Channel to read from
+*
+* Return
+*  bool: true if a command line was executed
+*
+*******************************************************************************/
+bool poll_channel(uart_tx_channel_t channel)
+{
+    console_t *console = &consoles[channel];
 
-    if (result == CY_RSLT_SUCCESS)
+    while (console_getc(channel, &uart_read_value))
     {
+        if (uart_read_value == ASCII_RETURN_CARRIAGE)
+        {
+            /* An overlong line is passed on as invalid */
+            execute_command_line(channel, console->line, console->overflow ?
+                                 (COMMAND_LINE_SIZE + 1u) : console->length);
 
-        for (index = 0; index < PASSWORD_LENGTH;)
+            console->length = 0;
+            console->overflow = false;
+            return true;
+        }
+        else if (console->length < COMMAND_LINE_SIZE)
+        {
+            console->line[console->length++] = uart_read_value;
+        }
+        else
         {
-            /* Generate a random 32 bit number*/
-            random_val = cyhal_trng_generate(&trng_obj);
+            console->overflow = true;
+        }
+    }
 
-            uint8_t bit_position  = 0;
+    return false;
+}
 
-            for(int8_t j=0;j<4;j++)
-            {
-                /* extract byte from the bit position offset 0, 8, 16, and 24. */
-                temp_value=((random_val>>bit_position )& ASCII_7BIT_MASK);
-                temp_value=check_range(temp_value);
-                password[index++] = temp_value;
-                bit_position  = bit_position  + 8;
-            }
-         }
+/*******************************************************************************
+* Function Name: console_getc
+********************************************************************************
+* Summary: This function takes one received character of a channel.
+*
+* Parameters:
+*  channel: Channel to read from
+*  value: Location to store the character
+*
+* Return
+*  bool: false if no character has been received
+*
+*******************************************************************************/
+bool console_getc(uart_tx_channel_t channel, uint8_t *value)
+{
+#if defined(USB_CDC_ENABLE)
+    if (channel == UART_TX_CHANNEL_USB)
+    {
+        usb_cdc_process();
+        return usb_cdc_getc(value);
+    }
+#else
+    CY_UNUSED_PARAMETER(channel);
+#endif
 
-        /* Terminate the password with end of string character */
-        password[index] = '\0';
+    return uart_rx_getc(value);
+}
 
-        /* Display the generated password on the UART Terminal */
-        printf("One-Time Password: %s\r\n\n",password);
-        printf("Press the Enter key to generate new password\r\n");
-        printf(SCREEN_HEADER1);
+/*******************************************************************************
+* Function Name: console_rx_pending
+********************************************************************************
+* Summary: This function returns whether received characters are waiting on
+*          any channel.
+*
+* Parameters:
+*  None
+*
+* Return
+*  bool
+*
+*******************************************************************************/
+bool console_rx_pending(void)
+{
+#if defined(USB_CDC_ENABLE)
+    if (usb_cdc_rx_pending())
+    {
+        return true;
+    }
+#endif
+
+    return uart_rx_pending();
+}
+
+/*******************************************************************************
+* Function Name: execute_command_line
+********************************************************************************
+* Summary: This function executes a command line and sends the response on
+*          the channel the line was received on. With FreeRTOS, the command
+*          runs in the harvester task of the entropy service, which owns the
+*          TRNG and the random source.
+*
+* Parameters:
+*  channel: Channel the line was received on
+*  line: Received characters, without the carriage return
+*  length: Number of received characters
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void execute_command_line(uart_tx_channel_t channel, const uint8_t *line,
+                          uint32_t length)
+{
+#if defined(COMPONENT_FREERTOS)
+    command_job_t job =
+    {
+        .channel = channel,
+        .line = line,
+        .length = length
+    };
+
+    (void)entropy_service_call(run_command_job, &job,
+                               ENTROPY_PRIORITY_NORMAL);
+#else
+    uart_tx_set_channel(channel);
+    process_command(line, length);
+#endif
+}
+
+#if defined(COMPONENT_FREERTOS)
+/*******************************************************************************
+* Function Name: console_task
+********************************************************************************
+* Summary: Console task. Polls the UART receive buffer every CONSOLE_POLL_MS
+*          and has the harvester queue the next password.
+*
+* Parameters:
+*  arg: Not used
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void console_task(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    for (;;)
+    {
+        poll_console();
+
+        if (!otp_queue_is_full() || uart_tx_secret_pending())
+        {
+            (void)entropy_service_call(refill_otp_job, NULL,
+                                       ENTROPY_PRIORITY_NORMAL);
+        }
+
+        if (stream_is_active())
+        {
+            (void)entropy_service_call(stream_job, NULL,
+                                       ENTROPY_PRIORITY_NORMAL);
+        }
 
-        /* Free the TRNG generator block */
-        cyhal_trng_free(&trng_obj);
+        vTaskDelay(pdMS_TO_TICKS(CONSOLE_POLL_MS));
     }
 }
 
 /*******************************************************************************
-* Function Name: check_range
+* Function Name: run_command_job
+********************************************************************************
+* Summary: This function executes a command line in the harvester task.
+*
+* Parameters:
+*  arg: command_job_t of the line
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void run_command_job(void *arg)
+{
+    const command_job_t *job = (const command_job_t *)arg;
+
+    uart_tx_set_channel(job->channel);
+    process_command(job->line, job->length);
+}
+
+/*******************************************************************************
+* Function Name: refill_otp_job
+********************************************************************************
+* Summary: This function wipes the sent secret output and generates the next
+*          queued password in the harvester task.
+*
+* Parameters:
+*  arg: Not used
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void refill_otp_job(void *arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+
+    uart_tx_scrub();
+    (void)otp_queue_process();
+}
+
+/*******************************************************************************
+* Function Name: stream_job
 ********************************************************************************
-* Summary: This function check if the generated random number is in the 
-*          range of alpha-numeric, special characters ASCII codes.  
-*          If not, convert to that range
+* Summary: This function sends stream frames in the harvester task until the
+*          credits are used up or a character has been received, so a new
+*          credit grant or R0 is not delayed behind the stream.
 *
 * Parameters:
-*  uint8_t
+*  arg: Not used
 *
 * Return
-*  uint8_t 
+*  void
 *
 *******************************************************************************/
-uint8_t check_range(uint8_t value)
+void stream_job(void *arg)
 {
-    if (value < ASCII_VISIBLE_CHARACTER_START)
+    CY_UNUSED_PARAMETER(arg);
+
+    while (stream_process() && !console_rx_pending())
     {
-         value += ASCII_VISIBLE_CHARACTER_START;
+        /* Next frame */
     }
-     return value;
+}
+#endif
+
+/*******************************************************************************
+* Function Name: update_otp_queue
+********************************************************************************
+* Summary: This function applies the password settings to the OTP queue. The
+*          queued passwords are discarded.
+*
+* Parameters:
+*  None
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void update_otp_queue(void)
+{
+    otp_queue_configure(alphabet_get(password_settings.alphabet),
+                        password_settings.length);
+}
+
+/*******************************************************************************
+* Function Name: process_command
+********************************************************************************
+* Summary: This function executes a command line received from the terminal.
+*          An empty line generates a single password and B<count> generates
+*          a batch of passwords.
+*
+* Parameters:
+*  line: Received characters, without the carriage return
+*  length: Number of received characters
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void process_command(const uint8_t *line, uint32_t length)
+{
+    command_t command;
+
+    command_parse(line, length, &command);
+
+    if (consoles[uart_tx_get_channel()].output_mode == OUTPUT_MODE_BINARY)
+    {
+        process_binary_command(&command);
+        uart_tx_flush();
+        return;
+    }
+
+    switch (command.type)
+    {
+        case COMMAND_GENERATE:
+            if (password_settings.count > 1u)
+            {
+                generate_password_batch(password_settings.count);
+            }
+            else
+            {
+                generate_password();
+            }
+            break;
+
+        case COMMAND_BATCH:
+            if ((command.value == 0u) || (command.value > BATCH_MAX_COUNT))
+            {
+                uart_tx_printf("Batch count must be 1 to %u\r\n",
+                               BATCH_MAX_COUNT);
+            }
+            else
+            {
+                generate_password_batch(command.value);
+            }
+            break;
+
+        case COMMAND_LENGTH:
+            if ((command.value == 0u) || (command.value > PASSWORD_MAX_LENGTH))
+            {
+                uart_tx_printf("Length must be 1 to %u\r\n",
+                               PASSWORD_MAX_LENGTH);
+            }
+            else
+            {
+                password_settings.length = command.value;
+                update_otp_queue();
+                print_settings();
+            }
+            break;
+
+        case COMMAND_ALPHABET:
+            password_settings.alphabet = (alphabet_id_t)command.value;
+            update_otp_queue();
+            print_settings();
+            break;
+
+        case COMMAND_COUNT:
+            if ((command.value == 0u) || (command.value > BATCH_MAX_COUNT))
+            {
+                uart_tx_printf("Count must be 1 to %u\r\n", BATCH_MAX_COUNT);
+            }
+            else
+            {
+                password_settings.count = command.value;
+                print_settings();
+            }
+            break;
+
+        case COMMAND_SETTINGS:
+            print_settings();
+            break;
+
+        case COMMAND_MODE:
+            if ((command.value == 1u) &&
+                (uart_tx_get_channel() == UART_TX_CHANNEL_UART))
+            {
+                uart_tx_printf("Switching to binary mode at %u baud\r\n",
+                               BINARY_MODE_BAUDRATE);
+                set_output_mode(OUTPUT_MODE_BINARY);
+            }
+            else if (command.value == 1u)
+            {
+                uart_tx_puts("Switching to binary mode\r\n");
+                set_output_mode(OUTPUT_MODE_BINARY);
+            }
+            else if (command.value == 0u)
+            {
+                /* Already in text mode, confirmed like the switch back */
+                print_settings();
+            }
+            else
+            {
+                uart_tx_puts("Mode must be 0 (text) or 1 (binary)\r\n");
+            }
+            break;
+
+        case COMMAND_SOURCE:
+            /* Instantiation fails if the TRNG was out of use at startup */
+            if ((command.value == (uint32_t)RANDOM_SOURCE_DRBG) &&
+                !drbg_available)
+            {
+                drbg_available = (drbg_init() == CY_RSLT_SUCCESS);
+            }
+
+            if ((command.value == (uint32_t)RANDOM_SOURCE_DRBG) &&
+                !drbg_available)
+            {
+                uart_tx_puts("DRBG not available\r\n");
+            }
+            else if (random_source_select((random_source_t)command.value)
+                     != CY_RSLT_SUCCESS)
+            {
+                uart_tx_puts("Source must be 0 (TRNG) or 1 (DRBG)\r\n");
+            }
+            else
+            {
+                otp_queue_flush();
+                print_settings();
+            }
+            break;
+
+        case COMMAND_RESEED:
+            if ((command.value == 0u) ||
+                (command.value > DRBG_MAX_RESEED_INTERVAL))
+            {
+                uart_tx_printf("Reseed interval must be 1 to %lu\r\n",
+                               (unsigned long)DRBG_MAX_RESEED_INTERVAL);
+            }
+            else
+            {
+                drbg_set_reseed_interval(command.value);
+                print_settings();
+            }
+            break;
+
+        case COMMAND_LOW_POWER:
+#if defined(LOW_POWER_AVAILABLE)
+            if (command.value > 1u)
+            {
+                uart_tx_puts("Low power mode must be 0 (off) or 1 (on)\r\n");
+            }
+            else
+            {
+                low_power_enabled = (command.value == 1u);
+                print_settings();
+            }
+#else
+            uart_tx_puts("Low power mode is only available in the bare-metal "
+                         "build\r\n");
+#endif
+            break;
+
+        case COMMAND_OSCILLATORS:
+        case COMMAND_SAMPLE_DIV:
+        case COMMAND_BIT_COUNT:
+#if defined(ENTROPY_IPC_ENABLE)
+            /* The TRNG is configured by the CM0+ application */
+            uart_tx_puts("The TRNG is owned by the CM0+\r\n");
+#else
+            configure_trng(&command);
+#endif
+            break;
+
+        case COMMAND_ENROLL:
+        case COMMAND_HOTP:
+        case COMMAND_TOTP:
+        case COMMAND_TIME:
+            process_otp_command(&command);
+            break;
+
+        case COMMAND_STATS:
+#if defined(TRNG_STATS_ENABLE)
+            trng_stats_print();
+#else
+            uart_tx_puts("Statistics not included, build with STATS=1\r\n");
+#endif
+            break;
+
+        case COMMAND_EXPORT:
+            uart_tx_puts("X<bytes> is only available in binary mode (M1)\r\n");
+            break;
+
+        case COMMAND_STREAM:
+            uart_tx_puts("R<credits> is only available in binary mode "
+                         "(M1)\r\n");
+            break;
+
+        case COMMAND_CAPTURE:
+            uart_tx_puts("N<words> is only available in binary mode "
+                         "(M1)\r\n");
+            break;
+
+        default:
+            uart_tx_puts("Unknown command\r\n");
+            break;
+    }
+
+    /* Send the response of the command */
+    uart_tx_flush();
+}
+
+/*******************************************************************************
+* Function Name: process_binary_command
+********************************************************************************
+* Summary: This function executes a command in binary mode. Every command is
+*          answered with frames only: X<bytes> exports random bytes followed
+*          by a status frame, R<credits> starts or continues the stream and
+*          R0 ends it, N<words> captures raw noise samples and sends them
+*          followed by a status frame, M0 acknowledges and returns to text
+*          mode, and any other command gets an unsupported status frame.
+*
+* Parameters:
+*  command: Decoded command
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void process_binary_command(const command_t *command)
+{
+    if ((command->type == COMMAND_EXPORT) && (command->value > 0u))
+    {
+        export_random_frames(command->value);
+    }
+    else if ((command->type == COMMAND_STREAM) && (command->value > 0u))
+    {
+        stream_grant(command->value);
+    }
+    else if (command->type == COMMAND_STREAM)
+    {
+        stream_stop();
+    }
+#if !defined(ENTROPY_IPC_ENABLE)
+    else if (command->type == COMMAND_CAPTURE)
+    {
+        capture_raw_noise(command->value);
+    }
+#endif
+    else if ((command->type == COMMAND_MODE) && (command->value == 0u))
+    {
+        stream_stop();
+        frame_write_status(FRAME_STATUS_OK);
+        set_output_mode(OUTPUT_MODE_TEXT);
+        print_settings();
+    }
+    else
+    {
+        frame_write_status(FRAME_STATUS_UNSUPPORTED);
+        uart_tx_flush();
+    }
+}
+
+/*******************************************************************************
+* Function Name: set_output_mode
+********************************************************************************
+* Summary: This function switches the current channel between text and
+*          binary framing. On the UART, the matching baud rate is set once
+*          all pending output has been sent. The USB channel has no baud rate.
+*
+* Parameters:
+*  mode: New output mode
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void set_output_mode(output_mode_t mode)
+{
+    uart_tx_channel_t channel = uart_tx_get_channel();
+    uint32_t baud = (mode == OUTPUT_MODE_BINARY) ? BINARY_MODE_BAUDRATE :
+                    CY_RETARGET_IO_BAUDRATE;
+
+    if ((channel != UART_TX_CHANNEL_UART) ||
+        (uart_tx_set_baud(baud) == CY_RSLT_SUCCESS))
+    {
+        consoles[channel].output_mode = mode;
+    }
+}
+
+/*******************************************************************************
+* Function Name: export_random_frames
+********************************************************************************
+* Summary: This function sends random bytes in FRAME_TYPE_RANDOM frames of up
+*          to FRAME_MAX_PAYLOAD bytes, followed by a status frame. The bytes
+*          are generated directly into the UART transmit buffer.
+*
+* Parameters:
+*  length: Number of random bytes to export
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void export_random_frames(uint32_t length)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint16_t chunk;
+    uint8_t *payload;
+
+    /* The payloads are wiped from the transmit buffers once sent */
+    uart_tx_set_secret(true);
+
+    while ((length > 0u) && (result == CY_RSLT_SUCCESS))
+    {
+        chunk = (length > FRAME_MAX_PAYLOAD) ? FRAME_MAX_PAYLOAD :
+                (uint16_t)length;
+
+        payload = frame_begin(FRAME_TYPE_RANDOM, chunk);
+        result = trng_fill(payload, chunk);
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            frame_end();
+            length -= chunk;
+        }
+        else
+        {
+            frame_abort();
+        }
+    }
+
+    uart_tx_set_secret(false);
+
+    frame_write_status((result == CY_RSLT_SUCCESS) ? FRAME_STATUS_OK :
+                       FRAME_STATUS_ERROR);
+    uart_tx_flush();
+}
+
+/*******************************************************************************
+* Function Name: capture_raw_noise
+********************************************************************************
+* Summary: This function records raw TRNG samples into RAM and sends them in
+*          FRAME_TYPE_RAW frames, followed by a status frame. The words
+*          already harvested into the entropy pool are not affected.
+*
+* Parameters:
+*  words: Number of 32-bit words, 1 to RAW_CAPTURE_MAX_WORDS
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void capture_raw_noise(uint32_t words)
+{
+    cy_rslt_t result;
+
+    result = raw_capture_record(words);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        raw_capture_send();
+    }
+
+    frame_write_status((result == CY_RSLT_SUCCESS) ? FRAME_STATUS_OK :
+                       FRAME_STATUS_ERROR);
+    uart_tx_flush();
+}
+
+/*******************************************************************************
+* Function Name: process_otp_command
+********************************************************************************
+* Summary: This function executes the HOTP/TOTP commands: E generates a new
+*          shared secret and shows it once in base32 for enrollment, H shows
+*          the next HOTP code, T<unix time> sets the RTC and T shows the
+*          TOTP code of the current time step.
+*
+* Parameters:
+*  command: Decoded command
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void process_otp_command(const command_t *command)
+{
+    static char secret_text[HOTP_SECRET_BASE32_LENGTH + 1u];
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint64_t counter;
+    uint32_t remaining;
+    uint32_t code;
+
+    /* Shared secret and codes are wiped from the transmit buffers once sent */
+    uart_tx_set_secret(true);
+
+    switch (command->type)
+    {
+        case COMMAND_ENROLL:
+            result = hotp_new_secret();
+            if (result == CY_RSLT_SUCCESS)
+            {
+                hotp_secret_base32(secret_text);
+                uart_tx_printf("Shared secret (base32): %s\r\n"
+                               "HOTP counter reset to 0\r\n", secret_text);
+                zeroize(secret_text, sizeof(secret_text));
+            }
+            break;
+
+        case COMMAND_HOTP:
+            result = hotp_next(&code, &counter);
+            if (result == CY_RSLT_SUCCESS)
+            {
+                uart_tx_printf("HOTP %llu: %0*lu\r\n",
+                               (unsigned long long)counter, HOTP_DIGITS,
+                               (unsigned long)code);
+            }
+            break;
+
+        case COMMAND_TIME:
+            result = totp_set_time(command->value);
+            if (result == CY_RSLT_SUCCESS)
+            {
+                uart_tx_printf("Time set to %lu\r\n",
+                               (unsigned long)command->value);
+            }
+            break;
+
+        default:
+            result = totp_now(&code, &remaining);
+            if (result == CY_RSLT_SUCCESS)
+            {
+                uart_tx_printf("TOTP: %0*lu, valid for %lu s\r\n",
+                               HOTP_DIGITS, (unsigned long)code,
+                               (unsigned long)remaining);
+            }
+            break;
+    }
+
+    uart_tx_set_secret(false);
+
+    if (result == APP_RSLT_ERR_NOT_READY)
+    {
+        uart_tx_puts(hotp_has_secret() ? "Set the time with T<unix time> "
+                     "first\r\n" : "No shared secret, enter E first\r\n");
+    }
+    else if ((result != CY_RSLT_SUCCESS) &&
+             (command->type == COMMAND_ENROLL))
+    {
+        report_generation_error();
+    }
+    else if (result != CY_RSLT_SUCCESS)
+    {
+        uart_tx_puts("HMAC or RTC operation failed\r\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: configure_trng
+********************************************************************************
+* Summary: This function applies an O<mask>, K<divider> or W<bits> command to
+*          the TRNG configuration and restarts the TRNG session with it. O0
+*          returns to the HAL default configuration. Words harvested with the
+*          previous configuration are discarded.
+*
+* Parameters:
+*  command: Decoded command
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void configure_trng(const command_t *command)
+{
+    trng_session_config_t config = trng_config;
+    bool use_default = false;
+
+    switch (command->type)
+    {
+        case COMMAND_OSCILLATORS:
+            use_default = (command->value == 0u);
+            config.oscillator_mask = (command->value <=
+                                      TRNG_SESSION_ALL_OSCILLATORS) ?
+                                     (uint8_t)command->value : 0u;
+            break;
+
+        case COMMAND_SAMPLE_DIV:
+            if (command->value > TRNG_MAX_SAMPLE_CLOCK_DIV)
+            {
+                uart_tx_printf("Divider must be 0 to %u\r\n",
+                               TRNG_MAX_SAMPLE_CLOCK_DIV);
+                return;
+            }
+            config.sample_clock_div = (uint8_t)command->value;
+            break;
+
+        default:
+            config.bit_count = (command->value <= TRNG_SESSION_MAX_BIT_COUNT) ?
+                               (uint8_t)command->value : 0u;
+            break;
+    }
+
+    if (use_default)
+    {
+        (void)trng_session_configure(NULL);
+    }
+    else if (trng_session_configure(&config) == CY_RSLT_SUCCESS)
+    {
+        trng_config = config;
+    }
+    else
+    {
+        uart_tx_puts("Invalid TRNG configuration, using HAL defaults\r\n");
+        (void)trng_session_configure(NULL);
+    }
+
+    entropy_pool_flush();
+    (void)random_source_select(random_source_get());
+    otp_queue_flush();
+    print_settings();
+}
+
+/*******************************************************************************
+* Function Name: report_generation_error
+********************************************************************************
+* Summary: This function reports why no password was generated. Nothing is
+*          sent for the failed password.
+*
+* Parameters:
+*  None
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void report_generation_error(void)
+{
+    if (trng_recovery_get_state() == TRNG_RECOVERY_WAITING)
+    {
+        uart_tx_puts("\r\nTRNG fault, recovering. No password generated, "
+                     "try again\r\n");
+    }
+    else if (trng_recovery_get_state() == TRNG_RECOVERY_FAILED)
+    {
+        uart_tx_printf("\r\nTRNG recovery failed after %u attempts, no "
+                       "password generated. Reset the device\r\n",
+                       TRNG_RECOVERY_MAX_ATTEMPTS);
+    }
+    else if (health_test_get_status() != HEALTH_TEST_OK)
+    {
+        uart_tx_printf("\r\nTRNG health test failure (%s), no password "
+                       "generated. Reset the device\r\n",
+                       health_test_status_name(health_test_get_status()));
+    }
+    else
+    {
+        uart_tx_puts("\r\nRandom number generation failed\r\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: print_settings
+********************************************************************************
+* Summary: This function displays the current password settings and the
+*          available alphabets.
+*
+* Parameters:
+*  None
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void print_settings(void)
+{
+    uint32_t id;
+
+    uart_tx_printf("Length: %lu, alphabet: %s, count: %lu\r\n",
+                   (unsigned long)password_settings.length,
+                   alphabet_get(password_settings.alphabet)->name,
+                   (unsigned long)password_settings.count);
+
+    uart_tx_printf("Source: %s, DRBG reseed interval: %lu\r\n",
+                   (random_source_get() == RANDOM_SOURCE_DRBG) ?
+                   "DRBG" : "TRNG",
+                   (unsigned long)drbg_get_reseed_interval());
+
+    if (trng_session_get_config() != NULL)
+    {
+        uart_tx_printf("TRNG oscillators: 0x%02X, sample clock divider: %u, "
+                       "bits per run: %u\r\n", trng_config.oscillator_mask,
+                       trng_config.sample_clock_div, trng_config.bit_count);
+    }
+    else
+    {
+        uart_tx_puts("TRNG: HAL default configuration\r\n");
+    }
+
+    uart_tx_printf("Low power mode: %s\r\n",
+                   low_power_enabled ? "on" : "off");
+
+    uart_tx_printf("Health tests: %s\r\n",
+                   health_test_status_name(health_test_get_status()));
+
+    uart_tx_printf("TRNG fault recovery: %s, %lu faults recovered\r\n",
+                   trng_recovery_state_name(trng_recovery_get_state()),
+                   (unsigned long)trng_recovery_get_count());
+
+#if defined(USB_CDC_ENABLE)
+    uart_tx_printf("USB CDC: %s\r\n",
+                   usb_cdc_is_connected() ? "connected" : "not connected");
+#endif
+
+    uart_tx_puts("Alphabets:");
+    for (id = 0; id < (uint32_t)ALPHABET_COUNT; id++)
+    {
+        uart_tx_printf(" %lu=%s", (unsigned long)id,
+                       alphabet_get((alphabet_id_t)id)->name);
+    }
+    uart_tx_puts("\r\n");
+}
+
+/*******************************************************************************
+* Function Name: generate_password
+********************************************************************************
+* Summary: This function sends a password with the current length and
+*          alphabet settings. A pre-generated record from the OTP queue is
+*          sent when one is ready; otherwise the password is generated
+*          straight into the UART transmit buffer.
+*
+* Parameters:
+*  None
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void generate_password()
+{
+    cy_rslt_t result;
+
+    result = otp_queue_send();
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        result = write_otp_record(alphabet_get(password_settings.alphabet),
+                                  password_settings.length);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        /* Display the generated password on the UART Terminal */
+        uart_tx_puts("\n");
+        uart_tx_puts("Press the Enter key to generate new password\r\n");
+        uart_tx_puts(SCREEN_HEADER1);
+        uart_tx_flush();
+    }
+    else
+    {
+        report_generation_error();
+    }
+}
+
+/*******************************************************************************
+* Function Name: generate_password_batch
+********************************************************************************
+* Summary: This function generates a number of passwords in one pass. The
+*          records are written into the UART transmit buffers; one buffer is
+*          sent while the next passwords are generated into the other.
+*
+* Parameters:
+*  count: Number of passwords to generate
+*
+* Return
+*  void
+*
+*******************************************************************************/
+void generate_password_batch(uint32_t count)
+{
+    const alphabet_t *alphabet = alphabet_get(password_settings.alphabet);
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t generated;
+
+    for (generated = 0; (generated < count) && (result == CY_RSLT_SUCCESS);
+         generated++)
+    {
+        result = write_otp_record(alphabet, password_settings.length);
+    }
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        generated--;
+        report_generation_error();
+    }
+
+    uart_tx_printf("\r\n%lu passwords generated\r\n",
+                   (unsigned long)generated);
+    uart_tx_puts("Press the Enter key to generate new password\r\n");
+    uart_tx_puts(SCREEN_HEADER1);
+}
+
+/*******************************************************************************
+* Function Name: write_otp_record
+********************************************************************************
+* Summary: This function generates one password directly into the UART
+*          transmit buffer, framed as "One-Time Password: <password>".
+*
+* Parameters:
+*  alphabet: Alphabet to draw the characters from
+*  length: Number of characters
+*
+* Return
+*  cy_rslt_t: The record is not queued if generation failed
+*
+*******************************************************************************/
+cy_rslt_t write_otp_record(const alphabet_t *alphabet, uint32_t length)
+{
+    cy_rslt_t result;
+    uint8_t *record;
+
+    TRNG_STATS_TIMER_START(generate_start);
+
+    /* The record is generated straight into the transmit buffer and wiped
+       there once it has been sent */
+    uart_tx_set_secret(true);
+    record = uart_tx_reserve(OTP_RECORD_SIZE(length));
+
+    memcpy(record, OTP_RECORD_PREFIX, sizeof(OTP_RECORD_PREFIX) - 1u);
+
+    /* Draw the password characters uniformly from the alphabet */
+    result = alphabet_map(alphabet, &record[sizeof(OTP_RECORD_PREFIX) - 1u],
+                          length);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        memcpy(&record[OTP_RECORD_SIZE(length) -
+               (sizeof(OTP_RECORD_SUFFIX) - 1u)], OTP_RECORD_SUFFIX,
+               sizeof(OTP_RECORD_SUFFIX) - 1u);
+        uart_tx_commit(OTP_RECORD_SIZE(length));
+        TRNG_STATS_INC(passwords);
+    }
+    else
+    {
+        /* Characters of the failed password are never sent */
+        zeroize(record, OTP_RECORD_SIZE(length));
+    }
+
+    uart_tx_set_secret(false);
+
+    TRNG_STATS_TIMER_STOP(generate_cycles, generate_start);
+
+    return result;
 }
 
 /* [] END OF FILE */
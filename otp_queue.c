@@ -0,0 +1,272 @@
+/******************************************************************************
+* File Name:   otp_queue.c
+*
+* Description: This file contains the queue of pre-generated OTP records. The
+* records are generated and framed in the background, so sending a password
+* is a single UART transfer straight from the queue. Each record is wiped as
+* soon as its transfer has completed.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "otp_queue.h"
+#include "alphabet_fixed.h"
+#include "uart_tx.h"
+#include "zeroize.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define OTP_QUEUE_RECORD_SIZE           (OTP_RECORD_SIZE(OTP_QUEUE_MAX_LENGTH))
+
+#if (OTP_FIXED_LENGTH == 0u) || (OTP_FIXED_LENGTH > OTP_QUEUE_MAX_LENGTH)
+#error "OTP_FIXED_LENGTH must be 1 to OTP_QUEUE_MAX_LENGTH"
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static cy_rslt_t generate_password(uint8_t *out);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static uint8_t queue_records[OTP_QUEUE_DEPTH][OTP_QUEUE_RECORD_SIZE];
+
+/* Free-running indices of the records. Records from queue_sent to queue_tail
+   are sent and keep their slots until their transfers are complete; records
+   from queue_tail to queue_head are ready */
+static uint32_t queue_head = 0;
+static uint32_t queue_tail = 0;
+static uint32_t queue_sent = 0;
+
+/* Transfer of each sent record */
+static uint32_t queue_transfers[OTP_QUEUE_DEPTH];
+
+/* Settings of the queued records */
+static const alphabet_t *queue_alphabet = NULL;
+static uint32_t queue_length = 0;
+
+/* generate_fixed(): OTP_FIXED_LENGTH characters of OTP_FIXED_ALPHABET */
+ALPHABET_FIXED_GENERATOR(generate_fixed, OTP_FIXED_ALPHABET, OTP_FIXED_LENGTH)
+
+/*******************************************************************************
+* Function Name: otp_queue_configure
+********************************************************************************
+* Summary:
+* This function sets the alphabet and length of the queued passwords. Records
+* generated with the previous settings are wiped.
+*
+* Parameters:
+*  alphabet: Alphabet to draw the characters from
+*  length: Number of characters, 1 to OTP_QUEUE_MAX_LENGTH
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void otp_queue_configure(const alphabet_t *alphabet, uint32_t length)
+{
+    otp_queue_flush();
+
+    if ((length > 0u) && (length <= OTP_QUEUE_MAX_LENGTH))
+    {
+        queue_alphabet = alphabet;
+        queue_length = length;
+    }
+}
+
+/*******************************************************************************
+* Function Name: otp_queue_flush
+********************************************************************************
+* Summary:
+* This function wipes all ready records, for example after the random source
+* changed. Records being sent are wiped when their transfers complete.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void otp_queue_flush(void)
+{
+    while (queue_head != queue_tail)
+    {
+        queue_head--;
+        zeroize(queue_records[queue_head % OTP_QUEUE_DEPTH],
+                OTP_QUEUE_RECORD_SIZE);
+    }
+}
+
+/*******************************************************************************
+* Function Name: otp_queue_process
+********************************************************************************
+* Summary:
+* This function wipes the sent records whose transfers are complete and
+* generates at most one new record into a free slot. It is called from the
+* main loop.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: true if a record was generated and the queue is not full yet
+*
+*******************************************************************************/
+bool otp_queue_process(void)
+{
+    uint8_t *record;
+
+    while ((queue_sent != queue_tail) &&
+           uart_tx_is_sent(queue_transfers[queue_sent % OTP_QUEUE_DEPTH]))
+    {
+        zeroize(queue_records[queue_sent % OTP_QUEUE_DEPTH],
+                OTP_QUEUE_RECORD_SIZE);
+        queue_sent++;
+    }
+
+    if ((queue_alphabet == NULL) || otp_queue_is_full())
+    {
+        return false;
+    }
+
+    record = queue_records[queue_head % OTP_QUEUE_DEPTH];
+    memcpy(record, OTP_RECORD_PREFIX, sizeof(OTP_RECORD_PREFIX) - 1u);
+
+    if (generate_password(&record[sizeof(OTP_RECORD_PREFIX) - 1u])
+        != CY_RSLT_SUCCESS)
+    {
+        zeroize(record, OTP_QUEUE_RECORD_SIZE);
+        return false;
+    }
+
+    memcpy(&record[OTP_RECORD_SIZE(queue_length) -
+           (sizeof(OTP_RECORD_SUFFIX) - 1u)], OTP_RECORD_SUFFIX,
+           sizeof(OTP_RECORD_SUFFIX) - 1u);
+    queue_head++;
+
+    return !otp_queue_is_full();
+}
+
+/*******************************************************************************
+* Function Name: otp_queue_is_full
+********************************************************************************
+* Summary:
+* This function returns whether all OTP_QUEUE_DEPTH slots hold a record, ready
+* or still being sent.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool otp_queue_is_full(void)
+{
+    return ((queue_head - queue_sent) >= OTP_QUEUE_DEPTH);
+}
+
+/*******************************************************************************
+* Function Name: otp_queue_send
+********************************************************************************
+* Summary:
+* This function starts sending the oldest ready record. Nothing is generated
+* or waited for here, so the time until the record is on the wire does not
+* depend on the alphabet, on the random source, or on other output. The record
+* keeps its slot until otp_queue_process() wipes it after the transfer.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t: APP_RSLT_ERR_NOT_READY if no record is ready or the channel is
+*  busy
+*
+*******************************************************************************/
+cy_rslt_t otp_queue_send(void)
+{
+    uint32_t slot = queue_tail % OTP_QUEUE_DEPTH;
+    cy_rslt_t result;
+
+    if (queue_head == queue_tail)
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    result = uart_tx_send_direct(queue_records[slot],
+                                 OTP_RECORD_SIZE(queue_length),
+                                 &queue_transfers[slot]);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        queue_tail++;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: generate_password
+********************************************************************************
+* Summary:
+* This function writes the characters of one queued password. The specialized
+* generator is used when the settings match OTP_FIXED_ALPHABET and
+* OTP_FIXED_LENGTH, and alphabet_map() otherwise.
+*
+* Parameters:
+*  out: Buffer for queue_length characters
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t generate_password(uint8_t *out)
+{
+    if ((queue_length == OTP_FIXED_LENGTH) &&
+        (queue_alphabet == alphabet_get(ALPHABET_ID(OTP_FIXED_ALPHABET))))
+    {
+        return generate_fixed(out);
+    }
+
+    return alphabet_map(queue_alphabet, out, queue_length);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/******************************************************************************
+* File Name:   otp_queue.h
+*
+* Description: This file contains the interface of the queue of pre-generated
+* OTP records of the HAL: MCU Cryptography: True Random Number Generation
+* Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef OTP_QUEUE_H
+#define OTP_QUEUE_H
+
+#include "cyhal.h"
+#include "alphabet.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Records kept ready for sending */
+#define OTP_QUEUE_DEPTH                 (4u)
+
+/* Longest password a queued record can hold */
+#define OTP_QUEUE_MAX_LENGTH            (64u)
+
+/* Alphabet (name after ALPHABET_) and length of the specialized generator of
+   the queue. Records with other settings use alphabet_map() */
+#ifndef OTP_FIXED_ALPHABET
+#define OTP_FIXED_ALPHABET              PRINTABLE
+#endif
+
+#ifndef OTP_FIXED_LENGTH
+#define OTP_FIXED_LENGTH                (8u)
+#endif
+
+/* Framing of an OTP record */
+#define OTP_RECORD_PREFIX               "One-Time Password: "
+#define OTP_RECORD_SUFFIX               "\r\n"
+#define OTP_RECORD_SIZE(length)         (sizeof(OTP_RECORD_PREFIX) - 1u + \
+                                         (length) + \
+                                         sizeof(OTP_RECORD_SUFFIX) - 1u)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void otp_queue_configure(const alphabet_t *alphabet, uint32_t length);
+void otp_queue_flush(void);
+bool otp_queue_process(void);
+bool otp_queue_is_full(void);
+cy_rslt_t otp_queue_send(void);
+
+#endif /* OTP_QUEUE_H */
+
+/* [] END OF FILE */
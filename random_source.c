@@ -0,0 +1,224 @@
+/******************************************************************************
+* File Name:   random_source.c
+*
+* Description: This file contains the random word source. Consumers take 32-bit
+* words from here and the selected source decides whether they are the SHA-256
+* conditioned TRNG output or come from the CTR_DRBG.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "random_source.h"
+#include "conditioner.h"
+#include "drbg.h"
+#include "bit_reservoir.h"
+#include "trng_fill.h"
+#include "trng_recovery.h"
+#include "zeroize.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define DRBG_BUFFER_WORDS               (RANDOM_SOURCE_DRBG_BUFFER_SIZE / \
+                                         sizeof(uint32_t))
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static cy_rslt_t drbg_word(uint32_t *value);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static random_source_t selected_source = RANDOM_SOURCE_TRNG;
+
+/* DRBG output not handed out yet */
+static uint32_t drbg_buffer[DRBG_BUFFER_WORDS];
+static uint32_t drbg_buffer_index = DRBG_BUFFER_WORDS;
+
+/*******************************************************************************
+* Function Name: random_source_select
+********************************************************************************
+* Summary:
+* This function selects the source of random words. Output buffered by the
+* consumers from the previous source is discarded, so no word of one source
+* is handed out after the switch to the other.
+*
+* Parameters:
+*  source: New source
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t random_source_select(random_source_t source)
+{
+    if ((source != RANDOM_SOURCE_TRNG) && (source != RANDOM_SOURCE_DRBG))
+    {
+        return APP_RSLT_ERR_BAD_PARAM;
+    }
+
+    selected_source = source;
+
+    zeroize(drbg_buffer, sizeof(drbg_buffer));
+    drbg_buffer_index = DRBG_BUFFER_WORDS;
+
+    conditioner_flush();
+    bit_reservoir_flush();
+    trng_fill_flush();
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: random_source_get
+********************************************************************************
+* Summary:
+* This function returns the selected source.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  random_source_t
+*
+*******************************************************************************/
+random_source_t random_source_get(void)
+{
+    return selected_source;
+}
+
+/*******************************************************************************
+* Function Name: random_source_word
+********************************************************************************
+* Summary:
+* This function returns one random word from the selected source. In TRNG mode
+* the words are SHA-256 conditioned TRNG output and nothing else: while a
+* TRNG fault is recovered, the call fails with APP_RSLT_ERR_TRNG_RECOVERY, so
+* trng_fill() never passes DRBG output on as true random data. In DRBG mode
+* the words are served from a buffer refilled by one generate request of
+* RANDOM_SOURCE_DRBG_BUFFER_SIZE bytes.
+*
+* Parameters:
+*  value: Location to store the word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t random_source_word(uint32_t *value)
+{
+    if (selected_source == RANDOM_SOURCE_TRNG)
+    {
+        return conditioner_get(value);
+    }
+
+    return drbg_word(value);
+}
+
+/*******************************************************************************
+* Function Name: random_source_password_word
+********************************************************************************
+* Summary:
+* This function returns one random word for password and OTP generation. It
+* is random_source_word(), except that while a TRNG fault is recovered, TRNG
+* mode takes its words from the DRBG, so the reserve of generate requests left
+* before the next reseed bridges the recovery. Passwords do not need full
+* entropy words, unlike keys taken with trng_fill().
+*
+* Parameters:
+*  value: Location to store the word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t random_source_password_word(uint32_t *value)
+{
+    cy_rslt_t result = random_source_word(value);
+
+    if ((result != CY_RSLT_SUCCESS) &&
+        (selected_source == RANDOM_SOURCE_TRNG) && trng_recovery_is_active())
+    {
+        result = drbg_word(value);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: drbg_word
+********************************************************************************
+* Summary:
+* This function returns the next word of the DRBG buffer and refills the
+* buffer with one generate request when it is used up.
+*
+* Parameters:
+*  value: Location to store the word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t drbg_word(uint32_t *value)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (drbg_buffer_index >= DRBG_BUFFER_WORDS)
+    {
+        result = drbg_generate((uint8_t *)drbg_buffer,
+                               RANDOM_SOURCE_DRBG_BUFFER_SIZE);
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            drbg_buffer_index = 0;
+        }
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        *value = drbg_buffer[drbg_buffer_index];
+
+        /* A word is never handed out twice */
+        drbg_buffer[drbg_buffer_index] = 0;
+        drbg_buffer_index++;
+    }
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,133 @@
+/******************************************************************************
+* File Name:   raw_capture.c
+*
+* Description: This file contains the raw noise capture for offline entropy
+* assessment, for example with the SP 800-90B tools. The samples are recorded
+* into RAM at the full TRNG rate first and sent in binary frames afterwards,
+* so the UART speed has no influence on the sampling.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "raw_capture.h"
+#include "trng_session.h"
+#include "frame.h"
+#include "uart_tx.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static uint32_t capture_words[RAW_CAPTURE_MAX_WORDS];
+
+/* Number of words recorded by the last capture */
+static uint32_t capture_length = 0;
+
+/*******************************************************************************
+* Function Name: raw_capture_record
+********************************************************************************
+* Summary:
+* This function records raw TRNG samples into the capture buffer with
+* trng_session_capture(). Nothing is sent while recording.
+*
+* Parameters:
+*  words: Number of 32-bit words, 1 to RAW_CAPTURE_MAX_WORDS
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t raw_capture_record(uint32_t words)
+{
+    cy_rslt_t result;
+
+    if ((words == 0u) || (words > RAW_CAPTURE_MAX_WORDS))
+    {
+        return APP_RSLT_ERR_BAD_PARAM;
+    }
+
+    capture_length = 0;
+
+    /* Send pending output first, so no transfer runs during the capture */
+    uart_tx_flush();
+    uart_tx_wait();
+
+    result = trng_session_capture(capture_words, words);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        capture_length = words;
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: raw_capture_send
+********************************************************************************
+* Summary:
+* This function sends the last capture as FRAME_TYPE_RAW frames of up to
+* FRAME_MAX_PAYLOAD bytes. The words are sent in little-endian byte order.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void raw_capture_send(void)
+{
+    const uint8_t *data = (const uint8_t *)capture_words;
+    uint32_t remaining = capture_length * sizeof(uint32_t);
+    uint16_t chunk;
+
+    while (remaining > 0u)
+    {
+        chunk = (remaining > FRAME_MAX_PAYLOAD) ? FRAME_MAX_PAYLOAD :
+                (uint16_t)remaining;
+
+        memcpy(frame_begin(FRAME_TYPE_RAW, chunk), data, chunk);
+        frame_end();
+        uart_tx_flush();
+
+        data += chunk;
+        remaining -= chunk;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,198 @@
+/******************************************************************************
+* File Name:   stream.c
+*
+* Description: This file contains the credit-based random data stream of the
+* binary mode. The host grants credits and every credit is answered with one
+* random data frame of conditioned random bytes. The stream pauses when the
+* credits are used up and continues when the host grants more, so the host
+* paces the stream without hardware flow control. Each frame is generated
+* while the previous one is still sent from the other UART transmit buffer.
+* The stream is sent on the channel it was started on.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "stream.h"
+#include "frame.h"
+#include "trng_fill.h"
+#include "uart_tx.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static bool stream_active = false;
+
+/* Frames the host has granted and not yet received */
+static uint32_t stream_credits = 0;
+
+/* Channel the stream was started on */
+static uart_tx_channel_t stream_channel = UART_TX_CHANNEL_UART;
+
+/*******************************************************************************
+* Function Name: stream_grant
+********************************************************************************
+* Summary:
+* This function starts the stream on the current channel or adds credits to
+* the running stream. The outstanding credits are limited to
+* STREAM_MAX_CREDITS.
+*
+* Parameters:
+*  credits: Number of random data frames the host can take
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void stream_grant(uint32_t credits)
+{
+    if (!stream_active)
+    {
+        stream_channel = uart_tx_get_channel();
+        stream_active = true;
+    }
+
+    if (credits > (STREAM_MAX_CREDITS - stream_credits))
+    {
+        stream_credits = STREAM_MAX_CREDITS;
+    }
+    else
+    {
+        stream_credits += credits;
+    }
+}
+
+/*******************************************************************************
+* Function Name: stream_stop
+********************************************************************************
+* Summary:
+* This function ends the stream. The frames already queued are sent and the
+* end of the stream is marked with an OK status frame on the channel of the
+* stream. Nothing is sent if no stream is running.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void stream_stop(void)
+{
+    uart_tx_channel_t channel = uart_tx_get_channel();
+
+    if (stream_active)
+    {
+        stream_active = false;
+        stream_credits = 0;
+
+        uart_tx_set_channel(stream_channel);
+        frame_write_status(FRAME_STATUS_OK);
+        uart_tx_flush();
+        uart_tx_set_channel(channel);
+    }
+}
+
+/*******************************************************************************
+* Function Name: stream_process
+********************************************************************************
+* Summary:
+* This function generates one random data frame if a credit is left and
+* starts sending it. The transfer of the previous frame is only waited for
+* once the new frame is complete. A generation failure ends the stream with
+* an error status frame.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool: true if credits are left for another frame
+*
+*******************************************************************************/
+bool stream_process(void)
+{
+    uint8_t *payload;
+
+    if (!stream_active || (stream_credits == 0u))
+    {
+        return false;
+    }
+
+    uart_tx_set_channel(stream_channel);
+
+    /* The payload is wiped from the transmit buffer once sent */
+    uart_tx_set_secret(true);
+    payload = frame_begin(FRAME_TYPE_RANDOM, STREAM_CREDIT_BYTES);
+
+    if (trng_fill(payload, STREAM_CREDIT_BYTES) != CY_RSLT_SUCCESS)
+    {
+        frame_abort();
+        uart_tx_set_secret(false);
+        frame_write_status(FRAME_STATUS_ERROR);
+        uart_tx_flush();
+
+        stream_active = false;
+        stream_credits = 0;
+        return false;
+    }
+
+    frame_end();
+    uart_tx_set_secret(false);
+    uart_tx_flush();
+    stream_credits--;
+
+    return (stream_credits > 0u);
+}
+
+/*******************************************************************************
+* Function Name: stream_is_active
+********************************************************************************
+* Summary:
+* This function returns whether a stream is running, including a stream that
+* waits for credits.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool stream_is_active(void)
+{
+    return stream_active;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,69 @@
+/******************************************************************************
+* File Name:   stream.h
+*
+* Description: This file contains the interface of the credit-based random
+* data stream of the binary mode of the HAL: MCU Cryptography: True Random
+* Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef STREAM_H
+#define STREAM_H
+
+#include "cyhal.h"
+#include "frame.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Random bytes sent for each credit, one full random data frame */
+#define STREAM_CREDIT_BYTES             (FRAME_MAX_PAYLOAD)
+
+/* Credits that can be outstanding at once */
+#define STREAM_MAX_CREDITS              (0x00FFFFFFu)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void stream_grant(uint32_t credits);
+void stream_stop(void);
+bool stream_process(void);
+bool stream_is_active(void);
+
+#endif /* STREAM_H */
+
+/* [] END OF FILE */
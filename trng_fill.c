@@ -0,0 +1,158 @@
+/******************************************************************************
+* File Name:   trng_fill.c
+*
+* Description: This file contains the bulk random bytes API. Buffers of any
+* length are filled from the random source one 32-bit word at a time. Bytes left
+* over from the last word of a request are kept for the next request, so a
+* short tail never wastes a whole TRNG word.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "trng_fill.h"
+#include "random_source.h"
+#include "zeroize.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define WORD_SIZE_BYTES                 (4u)
+#define WORD_ALIGN_MASK                 (WORD_SIZE_BYTES - 1u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Unused bytes of the last word drawn, lowest byte first */
+static uint32_t carry_word = 0;
+static uint8_t carry_bytes = 0;
+
+/*******************************************************************************
+* Function Name: trng_fill
+********************************************************************************
+* Summary:
+* This function fills a buffer with true random bytes. Whole words are stored
+* directly when the buffer is word aligned. The remaining bytes of a partially
+* used word are returned first by the next call.
+*
+* Parameters:
+*  buf: Buffer to fill
+*  len: Number of bytes to write
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_fill(uint8_t *buf, size_t len)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t random_val;
+
+    /* Use up the bytes left over from the previous call */
+    while ((len > 0u) && (carry_bytes > 0u))
+    {
+        *buf++ = (uint8_t)carry_word;
+        carry_word >>= 8u;
+        carry_bytes--;
+        len--;
+    }
+
+    if (((uintptr_t)buf & WORD_ALIGN_MASK) == 0u)
+    {
+        /* Word aligned fast path */
+        while ((len >= WORD_SIZE_BYTES) && (result == CY_RSLT_SUCCESS))
+        {
+            result = random_source_word((uint32_t *)buf);
+            buf += WORD_SIZE_BYTES;
+            len -= WORD_SIZE_BYTES;
+        }
+    }
+    else
+    {
+        while ((len >= WORD_SIZE_BYTES) && (result == CY_RSLT_SUCCESS))
+        {
+            result = random_source_word(&random_val);
+            memcpy(buf, &random_val, WORD_SIZE_BYTES);
+            buf += WORD_SIZE_BYTES;
+            len -= WORD_SIZE_BYTES;
+        }
+    }
+
+    if ((len > 0u) && (result == CY_RSLT_SUCCESS))
+    {
+        /* Tail bytes. Keep the unused part of the word for the next call */
+        result = random_source_word(&random_val);
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            carry_bytes = (uint8_t)(WORD_SIZE_BYTES - len);
+
+            while (len > 0u)
+            {
+                *buf++ = (uint8_t)random_val;
+                random_val >>= 8u;
+                len--;
+            }
+
+            carry_word = random_val;
+        }
+    }
+
+    zeroize(&random_val, sizeof(random_val));
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: trng_fill_flush
+********************************************************************************
+* Summary:
+* This function discards the bytes kept from the last partially used word.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_fill_flush(void)
+{
+    zeroize(&carry_word, sizeof(carry_word));
+    carry_bytes = 0;
+}
+
+/* [] END OF FILE */
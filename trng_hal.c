@@ -0,0 +1,187 @@
+/******************************************************************************
+* File Name:   trng_hal.c
+*
+* Description: This file contains the TRNG hardware shim for the device. The
+* HAL TRNG driver powers the block up and down and generates words with the HAL
+* defaults, and the PDL crypto driver programs a tuned configuration and runs
+* TRNG runs of a chosen bit count.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#if !defined(TRNG_HAL_HOST)
+
+#include "cy_pdl.h"
+#include "trng_hal.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Polynomials of the flexible GARO31 and FIRO31 oscillators */
+#define TRNG_HAL_GARO31_POLYNOMIAL      (0x04C11DB7u)
+#define TRNG_HAL_FIRO31_POLYNOMIAL      (0x04C11DB7u)
+
+/* Cycles of the sample clock to wait after enabling the oscillators */
+#define TRNG_HAL_INIT_DELAY             (3u)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* TRNG object of the powered-up block */
+static cyhal_trng_t trng_obj;
+
+/*******************************************************************************
+* Function Name: trng_hal_init
+********************************************************************************
+* Summary:
+* This function reserves and powers up the TRNG block with the HAL defaults.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_hal_init(void)
+{
+    return cyhal_trng_init(&trng_obj);
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_free
+********************************************************************************
+* Summary:
+* This function powers down and releases the TRNG block.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_hal_free(void)
+{
+    cyhal_trng_free(&trng_obj);
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_generate
+********************************************************************************
+* Summary:
+* This function generates a 32-bit word with the HAL defaults.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t trng_hal_generate(void)
+{
+    return cyhal_trng_generate(&trng_obj);
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_configure
+********************************************************************************
+* Summary:
+* This function programs a tuned configuration into the TRNG of the crypto
+* block reserved by trng_hal_init().
+*
+* Parameters:
+*  config: Configuration to program
+*  von_neumann: Enable the von Neumann corrector, false for raw samples
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_hal_configure(const trng_session_config_t *config,
+                             bool von_neumann)
+{
+    uint8_t mask = config->oscillator_mask;
+
+    cy_stc_crypto_trng_config_t pdl_config =
+    {
+        .sampleClockDiv = config->sample_clock_div,
+        .reducedClockDiv = 0u,
+        .initDelay = TRNG_HAL_INIT_DELAY,
+        .vonNeumannCorrDisable = !von_neumann,
+        .stopImmediately = true,
+        .ro11Enable = ((mask & TRNG_SESSION_RO11) != 0u),
+        .ro15Enable = ((mask & TRNG_SESSION_RO15) != 0u),
+        .garo15Enable = ((mask & TRNG_SESSION_GARO15) != 0u),
+        .garo31Enable = ((mask & TRNG_SESSION_GARO31) != 0u),
+        .firo15Enable = ((mask & TRNG_SESSION_FIRO15) != 0u),
+        .firo31Enable = ((mask & TRNG_SESSION_FIRO31) != 0u),
+        .garo31Poly = TRNG_HAL_GARO31_POLYNOMIAL,
+        .firo31Poly = TRNG_HAL_FIRO31_POLYNOMIAL
+    };
+
+    return (Cy_Crypto_Core_Trng_Init(trng_obj.base, &pdl_config) ==
+            CY_CRYPTO_SUCCESS) ? CY_RSLT_SUCCESS : APP_RSLT_ERR_CRYPTO;
+}
+
+/*******************************************************************************
+* Function Name: trng_hal_read_bits
+********************************************************************************
+* Summary:
+* This function runs the TRNG for the given number of bits with the
+* configuration programmed by trng_hal_configure().
+*
+* Parameters:
+*  bits: Bits of the run, 1 to 32
+*  sample: Location to store the bits, in the low bits of the word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_hal_read_bits(uint8_t bits, uint32_t *sample)
+{
+    return ((Cy_Crypto_Core_Trng_Start(trng_obj.base, bits) ==
+             CY_CRYPTO_SUCCESS) &&
+            (Cy_Crypto_Core_Trng_ReadData(trng_obj.base, sample) ==
+             CY_CRYPTO_SUCCESS)) ? CY_RSLT_SUCCESS : APP_RSLT_ERR_CRYPTO;
+}
+
+#endif /* !TRNG_HAL_HOST */
+
+/* [] END OF FILE */
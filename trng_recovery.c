@@ -0,0 +1,360 @@
+/******************************************************************************
+* File Name:   trng_recovery.c
+*
+* Description: This file contains the recovery from TRNG faults. A failed TRNG
+* session or health test no longer stops the random number generation for good:
+* the TRNG is powered down, and after a backoff delay the crypto block is reset
+* and the session is reopened with a new startup test. Until then the consumers
+* fail at once instead of waiting for the hardware, and the random source falls
+* back to the DRBG while its reseed interval allows.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "trng_recovery.h"
+#include "trng_session.h"
+#include "health_test.h"
+#include "entropy_pool.h"
+#include "crypto_block.h"
+#include "drbg.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Frequency of the backoff timer */
+#define TRNG_RECOVERY_TIMER_FREQ_HZ     (10000u)
+#define TRNG_RECOVERY_TICKS_PER_MS      (TRNG_RECOVERY_TIMER_FREQ_HZ / 1000u)
+
+/* Interrupt priority of the backoff timer */
+#define TRNG_RECOVERY_TIMER_INTR_PRIORITY   (7u)
+
+#if ((TRNG_RECOVERY_MAX_BACKOFF_MS * TRNG_RECOVERY_TICKS_PER_MS) > 0xFFFFu)
+#error "TRNG_RECOVERY_MAX_BACKOFF_MS exceeds the 16-bit backoff timer"
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void schedule_attempt(void);
+static void backoff_timer_callback(void *callback_arg,
+                                   cyhal_timer_event_t event);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static trng_recovery_state_t recovery_state = TRNG_RECOVERY_IDLE;
+
+/* Attempts since the fault, and delay before the next one */
+static uint32_t recovery_attempts = 0;
+static uint32_t recovery_backoff_ms = TRNG_RECOVERY_BACKOFF_MS;
+
+/* Faults recovered since reset */
+static uint32_t recovery_count = 0;
+
+/* One-shot timer that ends the backoff delay */
+static cyhal_timer_t backoff_timer_obj;
+static volatile bool attempt_due = false;
+
+/*******************************************************************************
+* Function Name: trng_recovery_init
+********************************************************************************
+* Summary:
+* This function prepares the backoff timer. It must be called once before a
+* fault can be recovered.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_recovery_init(void)
+{
+    cy_rslt_t result;
+
+    result = cyhal_timer_init(&backoff_timer_obj, NC, NULL);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_set_frequency(&backoff_timer_obj,
+                                           TRNG_RECOVERY_TIMER_FREQ_HZ);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        cyhal_timer_register_callback(&backoff_timer_obj,
+                                      backoff_timer_callback, NULL);
+        cyhal_timer_enable_event(&backoff_timer_obj,
+                                 CYHAL_TIMER_IRQ_TERMINAL_COUNT,
+                                 TRNG_RECOVERY_TIMER_INTR_PRIORITY, true);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: trng_recovery_start
+********************************************************************************
+* Summary:
+* This function handles a failed TRNG session open or generate call, or a
+* latched health test failure. The session is closed, the words harvested
+* before the fault was detected are discarded, and the first attempt is
+* scheduled. A fault during a recovery is ignored. Must be called from thread
+* context.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_recovery_start(void)
+{
+    if (recovery_state == TRNG_RECOVERY_IDLE)
+    {
+        trng_session_close();
+        entropy_pool_flush();
+
+        recovery_state = TRNG_RECOVERY_WAITING;
+        recovery_attempts = 0;
+        recovery_backoff_ms = TRNG_RECOVERY_BACKOFF_MS;
+
+        schedule_attempt();
+    }
+}
+
+/*******************************************************************************
+* Function Name: trng_recovery_process
+********************************************************************************
+* Summary:
+* This function runs a recovery attempt once its backoff delay has expired:
+* the crypto block is reset, the health tests are cleared, and the session is
+* reopened, which runs the startup test. The attempt is bounded by one session
+* open. If it fails, the next attempt is scheduled with twice the delay, and
+* after TRNG_RECOVERY_MAX_ATTEMPTS attempts the TRNG is given up. It is called
+* from the main loop.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_recovery_process(void)
+{
+    if ((recovery_state != TRNG_RECOVERY_WAITING) || !attempt_due)
+    {
+        return;
+    }
+
+    attempt_due = false;
+    recovery_attempts++;
+
+    /* The AES key of the DRBG is lost with the reset and loaded again */
+    crypto_block_suspend();
+    crypto_block_resume();
+    (void)drbg_reload_key();
+
+    health_test_clear();
+
+    if (trng_session_open() == CY_RSLT_SUCCESS)
+    {
+        recovery_state = TRNG_RECOVERY_IDLE;
+        recovery_count++;
+    }
+    else if (recovery_attempts >= TRNG_RECOVERY_MAX_ATTEMPTS)
+    {
+        trng_session_close();
+        recovery_state = TRNG_RECOVERY_FAILED;
+    }
+    else
+    {
+        recovery_backoff_ms = (recovery_backoff_ms * 2u);
+        if (recovery_backoff_ms > TRNG_RECOVERY_MAX_BACKOFF_MS)
+        {
+            recovery_backoff_ms = TRNG_RECOVERY_MAX_BACKOFF_MS;
+        }
+
+        schedule_attempt();
+    }
+}
+
+/*******************************************************************************
+* Function Name: trng_recovery_is_active
+********************************************************************************
+* Summary:
+* This function returns whether the TRNG is out of use after a fault.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool trng_recovery_is_active(void)
+{
+    return (recovery_state != TRNG_RECOVERY_IDLE);
+}
+
+/*******************************************************************************
+* Function Name: trng_recovery_get_state
+********************************************************************************
+* Summary:
+* This function returns the state of the recovery.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  trng_recovery_state_t
+*
+*******************************************************************************/
+trng_recovery_state_t trng_recovery_get_state(void)
+{
+    return recovery_state;
+}
+
+/*******************************************************************************
+* Function Name: trng_recovery_get_count
+********************************************************************************
+* Summary:
+* This function returns the number of faults recovered since reset.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uint32_t
+*
+*******************************************************************************/
+uint32_t trng_recovery_get_count(void)
+{
+    return recovery_count;
+}
+
+/*******************************************************************************
+* Function Name: trng_recovery_state_name
+********************************************************************************
+* Summary:
+* This function returns a printable name of a recovery state.
+*
+* Parameters:
+*  state: Recovery state
+*
+* Return:
+*  const char *
+*
+*******************************************************************************/
+const char *trng_recovery_state_name(trng_recovery_state_t state)
+{
+    static const char *const names[] =
+    {
+        [TRNG_RECOVERY_IDLE] = "idle",
+        [TRNG_RECOVERY_WAITING] = "recovering",
+        [TRNG_RECOVERY_FAILED] = "failed"
+    };
+
+    return ((uint32_t)state < (sizeof(names) / sizeof(names[0]))) ?
+           names[state] : "unknown";
+}
+
+/*******************************************************************************
+* Function Name: schedule_attempt
+********************************************************************************
+* Summary:
+* This function starts the backoff timer for the next attempt.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void schedule_attempt(void)
+{
+    const cyhal_timer_cfg_t backoff_timer_cfg =
+    {
+        .compare_value = 0,
+        .period = (recovery_backoff_ms * TRNG_RECOVERY_TICKS_PER_MS) - 1u,
+        .direction = CYHAL_TIMER_DIR_UP,
+        .is_compare = false,
+        .is_continuous = false,
+        .value = 0
+    };
+
+    attempt_due = false;
+
+    (void)cyhal_timer_stop(&backoff_timer_obj);
+
+    /* Without the timer, the attempt is made on the next call */
+    if ((cyhal_timer_configure(&backoff_timer_obj, &backoff_timer_cfg) !=
+         CY_RSLT_SUCCESS) ||
+        (cyhal_timer_start(&backoff_timer_obj) != CY_RSLT_SUCCESS))
+    {
+        attempt_due = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: backoff_timer_callback
+********************************************************************************
+* Summary:
+* Backoff timer terminal count handler. Marks the next attempt as due.
+*
+* Parameters:
+*  callback_arg: Not used
+*  event: Timer event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void backoff_timer_callback(void *callback_arg,
+                                   cyhal_timer_event_t event)
+{
+    CY_UNUSED_PARAMETER(callback_arg);
+    CY_UNUSED_PARAMETER(event);
+
+    attempt_due = true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/******************************************************************************
+* File Name:   trng_recovery.h
+*
+* Description: This file contains the interface of the TRNG fault recovery of
+* the HAL: MCU Cryptography: True Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TRNG_RECOVERY_H
+#define TRNG_RECOVERY_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Recovery attempts after a fault before the TRNG is given up */
+#define TRNG_RECOVERY_MAX_ATTEMPTS      (5u)
+
+/* Delay before the first attempt. It doubles after every failed attempt */
+#define TRNG_RECOVERY_BACKOFF_MS        (10u)
+
+/* Longest delay between two attempts */
+#define TRNG_RECOVERY_MAX_BACKOFF_MS    (1000u)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+typedef enum
+{
+    TRNG_RECOVERY_IDLE,         /* No fault, the TRNG is in use */
+    TRNG_RECOVERY_WAITING,      /* Fault detected, next attempt scheduled */
+    TRNG_RECOVERY_FAILED        /* All attempts failed, reset required */
+} trng_recovery_state_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t trng_recovery_init(void);
+void trng_recovery_start(void);
+void trng_recovery_process(void);
+bool trng_recovery_is_active(void);
+trng_recovery_state_t trng_recovery_get_state(void);
+uint32_t trng_recovery_get_count(void);
+const char *trng_recovery_state_name(trng_recovery_state_t state);
+
+#endif /* TRNG_RECOVERY_H */
+
+/* [] END OF FILE */
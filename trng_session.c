@@ -0,0 +1,563 @@
+/******************************************************************************
+* File Name:   trng_session.c
+*
+* Description: This file contains the persistent TRNG session. The TRNG block is
+* initialized once and kept powered while random numbers are being requested.
+* It is released after TRNG_SESSION_IDLE_TIMEOUT_MS without any generate call
+* and brought up again on the next request.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "trng_session.h"
+#include "trng_hal.h"
+#include "health_test.h"
+#include "trng_stats.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Idle timer period in timer ticks */
+#define TRNG_SESSION_TIMER_PERIOD       ((TRNG_SESSION_IDLE_TIMEOUT_MS * \
+                                          TRNG_SESSION_TIMER_FREQ_HZ) / 1000u)
+
+/* Interrupt priority of the idle timer */
+#define TRNG_SESSION_TIMER_INTR_PRIORITY    (7u)
+
+/* Raw noise configuration used by trng_session_capture() with the HAL
+   defaults: all oscillators, undivided sample clock, full 32-bit runs */
+#define TRNG_SESSION_CAPTURE_DEFAULT    { TRNG_SESSION_ALL_OSCILLATORS, 0u, \
+                                          TRNG_SESSION_MAX_BIT_COUNT }
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void idle_timer_callback(void *callback_arg, cyhal_timer_event_t event);
+static cy_rslt_t run_startup_test(void);
+static cy_rslt_t generate_raw(uint32_t *value);
+static cy_rslt_t generate_configured(uint8_t bits, uint32_t *value);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Timer used to detect an idle session */
+static cyhal_timer_t idle_timer_obj;
+
+static bool session_open = false;
+
+/* Set by every generate call, cleared by the idle timer on each period */
+static volatile bool session_used = false;
+
+/* Set by the idle timer when a full period elapsed without a generate call */
+static volatile bool session_idle = false;
+
+/* Tuned configuration, used while config_active is set */
+static trng_session_config_t session_config;
+static bool config_active = false;
+
+/*******************************************************************************
+* Function Name: trng_session_init
+********************************************************************************
+* Summary:
+* This function configures the idle timer. It must be called once before any
+* other session function. The session itself is opened on the first request,
+* so a TRNG fault at startup is recovered like one at runtime.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_session_init(void)
+{
+    cy_rslt_t result;
+
+    const cyhal_timer_cfg_t idle_timer_cfg =
+    {
+        .compare_value = 0,
+        .period = TRNG_SESSION_TIMER_PERIOD - 1u,
+        .direction = CYHAL_TIMER_DIR_UP,
+        .is_compare = false,
+        .is_continuous = true,
+        .value = 0
+    };
+
+    result = cyhal_timer_init(&idle_timer_obj, NC, NULL);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_configure(&idle_timer_obj, &idle_timer_cfg);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_set_frequency(&idle_timer_obj,
+                                           TRNG_SESSION_TIMER_FREQ_HZ);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        cyhal_timer_register_callback(&idle_timer_obj, idle_timer_callback,
+                                      NULL);
+        cyhal_timer_enable_event(&idle_timer_obj,
+                                 CYHAL_TIMER_IRQ_TERMINAL_COUNT,
+                                 TRNG_SESSION_TIMER_INTR_PRIORITY, true);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: trng_session_configure
+********************************************************************************
+* Summary:
+* This function selects the TRNG configuration and restarts the session with
+* it. NULL returns to the HAL default configuration. With a bit count below
+* 32, several TRNG runs are combined so that every generated word still holds
+* 32 random bits. Must be called from thread context.
+*
+* Parameters:
+*  config: Tuned configuration, or NULL for the default configuration
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_session_configure(const trng_session_config_t *config)
+{
+    if ((config != NULL) &&
+        (((config->oscillator_mask & TRNG_SESSION_ALL_OSCILLATORS) == 0u) ||
+         ((config->oscillator_mask & ~TRNG_SESSION_ALL_OSCILLATORS) != 0u) ||
+         (config->bit_count == 0u) ||
+         (config->bit_count > TRNG_SESSION_MAX_BIT_COUNT)))
+    {
+        return APP_RSLT_ERR_BAD_PARAM;
+    }
+
+    trng_session_close();
+
+    if (config != NULL)
+    {
+        session_config = *config;
+    }
+    config_active = (config != NULL);
+
+    return trng_session_open();
+}
+
+/*******************************************************************************
+* Function Name: trng_session_get_config
+********************************************************************************
+* Summary:
+* This function returns the tuned configuration in use.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  const trng_session_config_t *: NULL if the HAL defaults are used
+*
+*******************************************************************************/
+const trng_session_config_t *trng_session_get_config(void)
+{
+    return config_active ? &session_config : NULL;
+}
+
+/*******************************************************************************
+* Function Name: trng_session_open
+********************************************************************************
+* Summary:
+* This function powers up the TRNG block, runs the health test startup test
+* and starts the idle timer. Calling it on an open session has no effect.
+* Must be called from thread context.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_session_open(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (!session_open)
+    {
+        /* Initialize the TRNG generator block */
+        result = trng_hal_init();
+
+        if ((result == CY_RSLT_SUCCESS) && config_active)
+        {
+            result = trng_hal_configure(&session_config, true);
+
+            if (result != CY_RSLT_SUCCESS)
+            {
+                trng_hal_free();
+            }
+        }
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            result = run_startup_test();
+
+            if (result != CY_RSLT_SUCCESS)
+            {
+                trng_hal_free();
+            }
+        }
+
+        if (result == CY_RSLT_SUCCESS)
+        {
+            session_open = true;
+            session_used = true;
+            session_idle = false;
+
+            (void)cyhal_timer_start(&idle_timer_obj);
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: trng_session_close
+********************************************************************************
+* Summary:
+* This function stops the idle timer and powers down the TRNG block. Calling it
+* on a closed session has no effect. Must be called from thread context.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_session_close(void)
+{
+    uint32_t saved_intr_status;
+
+    if (session_open)
+    {
+        /* Mark the session closed before the TRNG block is released so that a
+           refill interrupt never generates from a freed object */
+        saved_intr_status = cyhal_system_critical_section_enter();
+        session_open = false;
+        session_idle = false;
+        cyhal_system_critical_section_exit(saved_intr_status);
+
+        (void)cyhal_timer_stop(&idle_timer_obj);
+
+        /* Free the TRNG generator block */
+        trng_hal_free();
+    }
+}
+
+/*******************************************************************************
+* Function Name: trng_session_is_open
+********************************************************************************
+* Summary:
+* This function returns whether the TRNG block is currently powered up.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool trng_session_is_open(void)
+{
+    return session_open;
+}
+
+/*******************************************************************************
+* Function Name: trng_session_generate
+********************************************************************************
+* Summary:
+* This function generates a 32-bit true random number that passed the health
+* tests. A session closed by the idle timeout is reopened before generating,
+* so interrupt handlers must only call it while trng_session_is_open()
+* returns true.
+*
+* Parameters:
+*  value: Location to store the generated random number
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_session_generate(uint32_t *value)
+{
+    cy_rslt_t result = trng_session_open();
+    uint32_t word;
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = generate_raw(&word);
+        session_used = true;
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        if (health_test_feed(word))
+        {
+            *value = word;
+        }
+        else
+        {
+            result = APP_RSLT_ERR_HEALTH_TEST;
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: trng_session_capture
+********************************************************************************
+* Summary:
+* This function records raw noise samples for offline entropy assessment. The
+* TRNG runs with the tuned configuration, or with all oscillators if the HAL
+* defaults are in use, but without the von Neumann corrector, and the samples
+* are neither health tested nor conditioned. The session is closed for the
+* capture, so the refill interrupt does not take TRNG output in between, and
+* it reopens with the normal configuration and the startup test on the next
+* request. Must be called from thread context.
+*
+* Parameters:
+*  buffer: Location to store the samples
+*  words: Number of 32-bit words to record
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t trng_session_capture(uint32_t *buffer, uint32_t words)
+{
+    const trng_session_config_t capture_default =
+        TRNG_SESSION_CAPTURE_DEFAULT;
+    const trng_session_config_t *config = config_active ? &session_config :
+                                          &capture_default;
+    cy_rslt_t result;
+    uint32_t index;
+
+    trng_session_close();
+
+    result = trng_hal_init();
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = trng_hal_configure(config, false);
+
+        for (index = 0; (index < words) && (result == CY_RSLT_SUCCESS);
+             index++)
+        {
+            result = generate_configured(config->bit_count, &buffer[index]);
+        }
+
+        trng_hal_free();
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: trng_session_process
+********************************************************************************
+* Summary:
+* This function closes the session once the idle timer reported that no random
+* number was requested for a full timeout period. It is called from the main
+* loop.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_session_process(void)
+{
+    if (session_idle)
+    {
+        trng_session_close();
+    }
+}
+
+/*******************************************************************************
+* Function Name: run_startup_test
+********************************************************************************
+* Summary:
+* This function restarts the health tests and runs them on
+* HEALTH_TEST_STARTUP_WORDS words, which are discarded, before the session
+* output is used.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t run_startup_test(void)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t word;
+    uint32_t count;
+
+    health_test_start();
+
+    for (count = 0; (count < HEALTH_TEST_STARTUP_WORDS) &&
+                    (result == CY_RSLT_SUCCESS); count++)
+    {
+        result = generate_raw(&word);
+
+        if ((result == CY_RSLT_SUCCESS) && !health_test_feed(word))
+        {
+            result = APP_RSLT_ERR_HEALTH_TEST;
+        }
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: generate_raw
+********************************************************************************
+* Summary:
+* This function reads one 32-bit word from the TRNG block without testing it.
+*
+* Parameters:
+*  value: Location to store the word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t generate_raw(uint32_t *value)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (config_active)
+    {
+        result = generate_configured(session_config.bit_count, value);
+    }
+    else
+    {
+        /* Generate a random 32 bit number */
+        *value = trng_hal_generate();
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        TRNG_STATS_INC(trng_words);
+    }
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: generate_configured
+********************************************************************************
+* Summary:
+* This function builds a 32-bit random word from TRNG runs of the configured
+* bit count.
+*
+* Parameters:
+*  bits: Bits per TRNG run, 1 to 32
+*  value: Location to store the random word
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+static cy_rslt_t generate_configured(uint8_t bits, uint32_t *value)
+{
+    uint32_t word = 0;
+    uint32_t sample;
+    uint32_t filled;
+
+    for (filled = 0; filled < TRNG_SESSION_MAX_BIT_COUNT; filled += bits)
+    {
+        if (trng_hal_read_bits(bits, &sample) != CY_RSLT_SUCCESS)
+        {
+            return APP_RSLT_ERR_CRYPTO;
+        }
+
+        word |= (uint32_t)(sample & ((1ull << bits) - 1u)) << filled;
+    }
+
+    *value = word;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: idle_timer_callback
+********************************************************************************
+* Summary:
+* Idle timer terminal count handler. Marks the session idle when no generate
+* call happened since the previous period.
+*
+* Parameters:
+*  callback_arg: Not used
+*  event: Timer event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void idle_timer_callback(void *callback_arg, cyhal_timer_event_t event)
+{
+    CY_UNUSED_PARAMETER(callback_arg);
+    CY_UNUSED_PARAMETER(event);
+
+    if (session_used)
+    {
+        session_used = false;
+    }
+    else
+    {
+        session_idle = true;
+    }
+}
+
+/* [] END OF FILE */
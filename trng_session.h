@@ -0,0 +1,95 @@
+/******************************************************************************
+* File Name:   trng_session.h
+*
+* Description: This file contains the interface of the persistent TRNG session
+* used by the HAL: MCU Cryptography: True Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TRNG_SESSION_H
+#define TRNG_SESSION_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Time after the last generate call at which the TRNG block is powered down */
+#define TRNG_SESSION_IDLE_TIMEOUT_MS    (500u)
+
+/* Frequency of the free-running timer used to track the session idle time */
+#define TRNG_SESSION_TIMER_FREQ_HZ      (10000u)
+
+/* Ring oscillators for trng_session_config_t.oscillator_mask */
+#define TRNG_SESSION_RO11               (0x01u)
+#define TRNG_SESSION_RO15               (0x02u)
+#define TRNG_SESSION_GARO15             (0x04u)
+#define TRNG_SESSION_GARO31             (0x08u)
+#define TRNG_SESSION_FIRO15             (0x10u)
+#define TRNG_SESSION_FIRO31             (0x20u)
+#define TRNG_SESSION_ALL_OSCILLATORS    (0x3Fu)
+
+/* Largest number of bits produced by one TRNG run */
+#define TRNG_SESSION_MAX_BIT_COUNT      (32u)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+/* Tuned TRNG configuration used instead of the HAL defaults */
+typedef struct
+{
+    uint8_t oscillator_mask;    /* Mask of TRNG_SESSION_RO11 .. FIRO31 */
+    uint8_t sample_clock_div;   /* Sample clock = clk_hf / (div + 1) */
+    uint8_t bit_count;          /* Bits per TRNG run, 1 to 32 */
+} trng_session_config_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t trng_session_init(void);
+cy_rslt_t trng_session_configure(const trng_session_config_t *config);
+const trng_session_config_t *trng_session_get_config(void);
+cy_rslt_t trng_session_open(void);
+void trng_session_close(void);
+bool trng_session_is_open(void);
+cy_rslt_t trng_session_generate(uint32_t *value);
+cy_rslt_t trng_session_capture(uint32_t *buffer, uint32_t words);
+void trng_session_process(void);
+
+#endif /* TRNG_SESSION_H */
+
+/* [] END OF FILE */
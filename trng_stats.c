@@ -0,0 +1,118 @@
+/******************************************************************************
+* File Name:   trng_stats.c
+*
+* Description: This file contains the storage and the report of the optional
+* hot path counters.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "trng_stats.h"
+#include "uart_tx.h"
+
+#if defined(TRNG_STATS_ENABLE)
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+trng_stats_t trng_stats;
+
+/*******************************************************************************
+* Function Name: trng_stats_init
+********************************************************************************
+* Summary:
+* This function clears the counters and starts the DWT cycle counter used by
+* the cycle timers.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_stats_init(void)
+{
+    memset(&trng_stats, 0, sizeof(trng_stats));
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/*******************************************************************************
+* Function Name: trng_stats_print
+********************************************************************************
+* Summary:
+* This function prints all counters on the debug UART.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trng_stats_print(void)
+{
+    trng_stats_t snapshot;
+    uint32_t saved_intr_status;
+
+    /* The TRNG word counter is also updated by the refill interrupt */
+    saved_intr_status = cyhal_system_critical_section_enter();
+    snapshot = trng_stats;
+    cyhal_system_critical_section_exit(saved_intr_status);
+
+    uart_tx_printf("TRNG words: %lu, pool misses: %lu, SHA-256 digests: "
+                   "%lu\r\n",
+                   (unsigned long)snapshot.trng_words,
+                   (unsigned long)snapshot.pool_misses,
+                   (unsigned long)snapshot.digests);
+    uart_tx_printf("Passwords: %lu, rejected candidates: %lu, generate cycles: "
+                   "%llu\r\n", (unsigned long)snapshot.passwords,
+                   (unsigned long)snapshot.alphabet_rejects,
+                   (unsigned long long)snapshot.generate_cycles);
+    uart_tx_printf("RX bytes: %lu, TX bytes: %lu, TX wait cycles: %llu, "
+                   "sleeps: %lu\r\n", (unsigned long)snapshot.rx_bytes,
+                   (unsigned long)snapshot.tx_bytes,
+                   (unsigned long long)snapshot.tx_wait_cycles,
+                   (unsigned long)snapshot.sleeps);
+}
+
+#endif /* TRNG_STATS_ENABLE */
+
+/* [] END OF FILE */
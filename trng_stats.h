@@ -0,0 +1,103 @@
+/******************************************************************************
+* File Name:   trng_stats.h
+*
+* Description: This file contains the optional hot path counters of the HAL:
+* MCU Cryptography: True Random Number Generation Example. They are compiled
+* in only when TRNG_STATS_ENABLE is defined; otherwise every macro expands to
+* nothing.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TRNG_STATS_H
+#define TRNG_STATS_H
+
+#include "cyhal.h"
+
+#if defined(TRNG_STATS_ENABLE)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+typedef struct
+{
+    uint32_t trng_words;        /* Words read from the TRNG block */
+    uint32_t pool_misses;       /* Words generated with the pool empty */
+    uint32_t digests;           /* SHA-256 conditioning calls */
+    uint32_t alphabet_rejects;  /* Candidates rejected by alphabet_map() */
+    uint32_t passwords;         /* Passwords generated */
+    uint32_t rx_bytes;          /* Characters received */
+    uint32_t tx_bytes;          /* Bytes queued for asynchronous transmit */
+    uint32_t sleeps;            /* Sleep entries while waiting for input */
+    uint64_t generate_cycles;   /* Cycles spent generating passwords */
+    uint64_t tx_wait_cycles;    /* Cycles blocked on a busy transmitter */
+} trng_stats_t;
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+extern trng_stats_t trng_stats;
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define TRNG_STATS_INC(counter)             (trng_stats.counter++)
+#define TRNG_STATS_ADD(counter, amount)     (trng_stats.counter += (amount))
+
+/* Cycle timer on the DWT cycle counter. The counter stops while the CPU
+   sleeps, so only active time is measured */
+#define TRNG_STATS_TIMER_START(start)       uint32_t start = DWT->CYCCNT
+#define TRNG_STATS_TIMER_STOP(counter, start) \
+    (trng_stats.counter += (uint32_t)(DWT->CYCCNT - (start)))
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+void trng_stats_init(void);
+void trng_stats_print(void);
+
+#else
+
+#define TRNG_STATS_INC(counter)             ((void)0)
+#define TRNG_STATS_ADD(counter, amount)     ((void)0)
+#define TRNG_STATS_TIMER_START(start)       ((void)0)
+#define TRNG_STATS_TIMER_STOP(counter, start)   ((void)0)
+
+#endif /* TRNG_STATS_ENABLE */
+
+#endif /* TRNG_STATS_H */
+
+/* [] END OF FILE */
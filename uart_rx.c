@@ -0,0 +1,192 @@
+/******************************************************************************
+* File Name:   uart_rx.c
+*
+* Description: This file contains the interrupt-driven UART receive path. The RX
+* not-empty interrupt moves received characters into a ring buffer, so the
+* main loop can sleep until a character arrives instead of polling the UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "uart_rx.h"
+#include "trng_stats.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define UART_RX_INDEX_MASK              (UART_RX_BUFFER_SIZE - 1u)
+
+/* Interrupt priority of the UART receive event */
+#define UART_RX_INTR_PRIORITY           (3u)
+
+#if ((UART_RX_BUFFER_SIZE & UART_RX_INDEX_MASK) != 0u)
+#error "UART_RX_BUFFER_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void uart_rx_callback(void *callback_arg, cyhal_uart_event_t event);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static cyhal_uart_t *rx_uart_obj;
+
+/* Received characters. head is written only by the interrupt and tail only
+   by the main loop */
+static uint8_t rx_buffer[UART_RX_BUFFER_SIZE];
+static volatile uint32_t rx_head = 0;
+static volatile uint32_t rx_tail = 0;
+
+/*******************************************************************************
+* Function Name: uart_rx_init
+********************************************************************************
+* Summary:
+* This function enables the receive interrupt of an initialized UART.
+*
+* Parameters:
+*  uart_obj: UART to receive from
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t uart_rx_init(cyhal_uart_t *uart_obj)
+{
+    rx_uart_obj = uart_obj;
+
+    cyhal_uart_register_callback(uart_obj, uart_rx_callback, NULL);
+    cyhal_uart_enable_event(uart_obj, CYHAL_UART_IRQ_RX_NOT_EMPTY,
+                            UART_RX_INTR_PRIORITY, true);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: uart_rx_getc
+********************************************************************************
+* Summary:
+* This function takes the oldest received character without waiting.
+*
+* Parameters:
+*  value: Location to store the character
+*
+* Return:
+*  bool: true if a character was available
+*
+*******************************************************************************/
+bool uart_rx_getc(uint8_t *value)
+{
+    uint32_t tail = rx_tail;
+
+    if (rx_head == tail)
+    {
+        return false;
+    }
+
+    __DMB();
+    *value = rx_buffer[tail & UART_RX_INDEX_MASK];
+    __DMB();
+    rx_tail = tail + 1u;
+
+    TRNG_STATS_INC(rx_bytes);
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: uart_rx_pending
+********************************************************************************
+* Summary:
+* This function returns whether received characters are waiting to be read.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool uart_rx_pending(void)
+{
+    return (rx_head != rx_tail);
+}
+
+/*******************************************************************************
+* Function Name: uart_rx_callback
+********************************************************************************
+* Summary:
+* UART event handler. Drains the RX FIFO into the ring buffer. Characters that
+* do not fit are dropped.
+*
+* Parameters:
+*  callback_arg: Not used
+*  event: UART event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_rx_callback(void *callback_arg, cyhal_uart_event_t event)
+{
+    uint32_t head = rx_head;
+    uint8_t value;
+
+    CY_UNUSED_PARAMETER(callback_arg);
+
+    if ((event & CYHAL_UART_IRQ_RX_NOT_EMPTY) != 0u)
+    {
+        while (cyhal_uart_readable(rx_uart_obj) > 0u)
+        {
+            if (cyhal_uart_getc(rx_uart_obj, &value, 0) != CY_RSLT_SUCCESS)
+            {
+                break;
+            }
+
+            if ((head - rx_tail) < UART_RX_BUFFER_SIZE)
+            {
+                rx_buffer[head & UART_RX_INDEX_MASK] = value;
+                head++;
+            }
+        }
+
+        __DMB();
+        rx_head = head;
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,933 @@
+/******************************************************************************
+* File Name:   uart_tx.c
+*
+* Description: This file contains the asynchronous UART output queue. Output is
+* written directly into one of two transmit buffers. A full buffer is sent
+* with cyhal_uart_write_async(), using DMA where the device supports it, while
+* the next records are written into the other buffer. With USB_CDC_ENABLE the
+* USB CDC channel has its own pair of buffers, so a host that does not drain
+* the USB port never holds up the UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdarg.h>
+#include <string.h>
+#include "uart_tx.h"
+#include "trng_stats.h"
+#include "zeroize.h"
+#include "app_result.h"
+#if defined(USB_CDC_ENABLE)
+#include "usb_cdc.h"
+#endif
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define UART_TX_BUFFER_COUNT            (2u)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+/* Output queue of one channel */
+typedef struct
+{
+    uint8_t buffers[UART_TX_BUFFER_COUNT][UART_TX_BUFFER_SIZE];
+    uint32_t active;            /* Buffer currently being filled */
+    uint32_t length;            /* Bytes written to the active buffer */
+    uint32_t transfer;          /* Identifier of the last transfer started */
+    bool active_secret;         /* The active buffer holds secret output */
+
+    /* Bytes of each sent buffer to wipe once its transfer has completed */
+    uint32_t secret_length[UART_TX_BUFFER_COUNT];
+} tx_queue_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void put_char(char value);
+static uint32_t format_digits(uint64_t value, uint32_t base, bool upper);
+static void put_field(const char *text, uint32_t length, bool reversed,
+                      char sign, uint32_t width, bool left, char pad);
+static void flush_channel(uart_tx_channel_t channel);
+static void wait_channel(uart_tx_channel_t channel);
+static void scrub_buffer(tx_queue_t *queue, uint32_t buffer);
+static void start_transfer(uart_tx_channel_t channel, const uint8_t *data,
+                           uint32_t length);
+static bool transfer_active(uart_tx_channel_t channel);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+static cyhal_uart_t *tx_uart_obj;
+
+/* Channel the output is queued on, and its queue */
+static uart_tx_channel_t tx_channel = UART_TX_CHANNEL_UART;
+static tx_queue_t tx_queues[UART_TX_CHANNEL_COUNT];
+static tx_queue_t *tx_queue = &tx_queues[UART_TX_CHANNEL_UART];
+
+/* Number of asynchronous transfers started on all channels */
+static uint32_t tx_transfers = 0;
+
+/* Output queued now is secret */
+static bool tx_secret = false;
+
+/* Digits of the number being formatted, least significant first */
+static char tx_digits[UART_TX_DIGITS_SIZE];
+
+/*******************************************************************************
+* Function Name: uart_tx_init
+********************************************************************************
+* Summary:
+* This function prepares an initialized UART for asynchronous transmission.
+* DMA is used for the transfers if it is available, otherwise the transfers
+* are interrupt driven.
+*
+* Parameters:
+*  uart_obj: UART to transmit on
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t uart_tx_init(cyhal_uart_t *uart_obj)
+{
+    tx_uart_obj = uart_obj;
+
+    /* Fall back to interrupt-driven transfers if no DMA channel is free */
+    (void)cyhal_uart_set_async_mode(uart_obj, CYHAL_ASYNC_DMA,
+                                    CYHAL_DMA_PRIORITY_DEFAULT);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_reserve
+********************************************************************************
+* Summary:
+* This function returns space for length bytes in the active transmit buffer
+* of the current channel. If the active buffer cannot take the bytes, it is
+* sent first. The bytes are
+* queued by uart_tx_commit().
+*
+* Parameters:
+*  length: Number of bytes to be written
+*
+* Return:
+*  uint8_t *: Location to write to, NULL if length exceeds the buffer size
+*
+*******************************************************************************/
+uint8_t *uart_tx_reserve(uint32_t length)
+{
+    if (length > UART_TX_BUFFER_SIZE)
+    {
+        return NULL;
+    }
+
+    if ((tx_queue->length + length) > UART_TX_BUFFER_SIZE)
+    {
+        uart_tx_flush();
+    }
+
+    return &tx_queue->buffers[tx_queue->active][tx_queue->length];
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_commit
+********************************************************************************
+* Summary:
+* This function queues bytes written to the location returned by
+* uart_tx_reserve().
+*
+* Parameters:
+*  length: Number of bytes written, at most the reserved length
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_commit(uint32_t length)
+{
+    tx_queue->length += length;
+    tx_queue->active_secret |= tx_secret;
+
+    TRNG_STATS_ADD(tx_bytes, length);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_puts
+********************************************************************************
+* Summary:
+* This function queues a NULL terminated string. Strings longer than the
+* transmit buffer are split.
+*
+* Parameters:
+*  text: String to queue
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_puts(const char *text)
+{
+    uint32_t remaining = strlen(text);
+    uint32_t chunk;
+
+    while (remaining > 0u)
+    {
+        chunk = (remaining > UART_TX_BUFFER_SIZE) ?
+                UART_TX_BUFFER_SIZE : remaining;
+
+        memcpy(uart_tx_reserve(chunk), text, chunk);
+        uart_tx_commit(chunk);
+
+        text += chunk;
+        remaining -= chunk;
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_printf
+********************************************************************************
+* Summary:
+* This function formats text straight into the transmit buffers. It neither
+* allocates memory nor uses a line buffer, so it replaces printf() for all
+* output of the application. The output is sent with the next flush.
+* Supported are the conversions %d, %u, %x, %X, %c, %s and %% with the l and
+* ll length modifiers, the flags '-' and '0', and a field width, which can be
+* passed as an unsigned int argument with '*'. Any other conversion is copied
+* unchanged.
+*
+* Parameters:
+*  format: Format string
+*  ...: Arguments of the conversions
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_printf(const char *format, ...)
+{
+    va_list args;
+    const char *text;
+    uint64_t value;
+    uint32_t width;
+    uint32_t longs;
+    int64_t signed_value;
+    bool left;
+    char pad;
+    char sign;
+    char conversion;
+
+    va_start(args, format);
+
+    while (*format != '\0')
+    {
+        if (*format != '%')
+        {
+            put_char(*format++);
+            continue;
+        }
+
+        format++;
+        left = false;
+        pad = ' ';
+        sign = '\0';
+        width = 0;
+        longs = 0;
+
+        if (*format == '-')
+        {
+            left = true;
+            format++;
+        }
+
+        if (*format == '0')
+        {
+            pad = '0';
+            format++;
+        }
+
+        if (*format == '*')
+        {
+            width = va_arg(args, unsigned int);
+            format++;
+        }
+
+        while ((*format >= '0') && (*format <= '9'))
+        {
+            width = (width * 10u) + (uint32_t)(*format++ - '0');
+        }
+
+        while (*format == 'l')
+        {
+            longs++;
+            format++;
+        }
+
+        conversion = *format;
+
+        switch (conversion)
+        {
+            case 'd':
+                signed_value = (longs >= 2u) ? va_arg(args, long long) :
+                               (longs == 1u) ? va_arg(args, long) :
+                               va_arg(args, int);
+                if (signed_value < 0)
+                {
+                    sign = '-';
+                    value = 0u - (uint64_t)signed_value;
+                }
+                else
+                {
+                    value = (uint64_t)signed_value;
+                }
+                put_field(tx_digits, format_digits(value, 10u, false), true,
+                          sign, width, left, pad);
+                break;
+
+            case 'u':
+            case 'x':
+            case 'X':
+                value = (longs >= 2u) ? va_arg(args, unsigned long long) :
+                        (longs == 1u) ? va_arg(args, unsigned long) :
+                        va_arg(args, unsigned int);
+                put_field(tx_digits, format_digits(value,
+                          (conversion == 'u') ? 10u : 16u, (conversion == 'X')),
+                          true, sign, width, left, pad);
+                break;
+
+            case 'c':
+                tx_digits[0] = (char)va_arg(args, int);
+                put_field(tx_digits, 1u, false, sign, width, left, ' ');
+                break;
+
+            case 's':
+                text = va_arg(args, const char *);
+                put_field(text, strlen(text), false, sign, width, left, ' ');
+                break;
+
+            case '%':
+                put_char('%');
+                break;
+
+            default:
+                /* Not supported, copied as it is */
+                put_char('%');
+                if (conversion != '\0')
+                {
+                    put_char(conversion);
+                }
+                break;
+        }
+
+        if (conversion != '\0')
+        {
+            format++;
+        }
+    }
+
+    va_end(args);
+
+    /* The digits may have been those of a code */
+    zeroize(tx_digits, sizeof(tx_digits));
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_set_secret
+********************************************************************************
+* Summary:
+* This function marks the output queued from now on as secret, or ends the
+* marking. A transmit buffer that received secret output is wiped as soon as
+* its transfer has completed, at the latest by uart_tx_scrub() or when the
+* buffer is filled again. The output is still written only once, straight
+* into the transmit buffer it is sent from.
+*
+* Parameters:
+*  secret: true for secret output such as passwords and keys
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_set_secret(bool secret)
+{
+    tx_secret = secret;
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_scrub
+********************************************************************************
+* Summary:
+* This function wipes the sent buffers of all channels that held secret
+* output once their transfers have completed. Output left queued on a channel
+* that is no longer the current one is sent once that channel is idle. It is
+* called from the main loop.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_scrub(void)
+{
+    tx_queue_t *queue;
+    uint32_t channel;
+    uint32_t buffer;
+
+    for (channel = 0; channel < (uint32_t)UART_TX_CHANNEL_COUNT; channel++)
+    {
+        queue = &tx_queues[channel];
+
+        if (transfer_active((uart_tx_channel_t)channel))
+        {
+            continue;
+        }
+
+        for (buffer = 0; buffer < UART_TX_BUFFER_COUNT; buffer++)
+        {
+            if (buffer != queue->active)
+            {
+                scrub_buffer(queue, buffer);
+            }
+        }
+
+        if ((channel != (uint32_t)tx_channel) && (queue->length > 0u))
+        {
+            flush_channel((uart_tx_channel_t)channel);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_secret_pending
+********************************************************************************
+* Summary:
+* This function returns whether a sent buffer of any channel still holds
+* secret output that uart_tx_scrub() has to wipe.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool uart_tx_secret_pending(void)
+{
+    const tx_queue_t *queue;
+    uint32_t channel;
+    uint32_t buffer;
+    bool pending = false;
+
+    for (channel = 0; channel < (uint32_t)UART_TX_CHANNEL_COUNT; channel++)
+    {
+        queue = &tx_queues[channel];
+
+        for (buffer = 0; buffer < UART_TX_BUFFER_COUNT; buffer++)
+        {
+            pending = pending || ((buffer != queue->active) &&
+                                  (queue->secret_length[buffer] > 0u));
+        }
+    }
+
+    return pending;
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_flush
+********************************************************************************
+* Summary:
+* This function starts sending the active buffer of the current channel and
+* switches to the other buffer. It waits only if the previous transfer on the
+* channel has not finished yet.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_flush(void)
+{
+    flush_channel(tx_channel);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_send_direct
+********************************************************************************
+* Summary:
+* This function sends data straight from the caller's memory, without a copy
+* into the transmit buffers, on the current channel. The data is only sent
+* when the channel is idle, with no transfer in progress and no buffered
+* output, so the call never waits for other output. The data must stay
+* unchanged until uart_tx_is_sent() returns true for the stored transfer.
+*
+* Parameters:
+*  data: Data to send
+*  length: Number of bytes
+*  transfer: Location to store the transfer identifier for uart_tx_is_sent()
+*
+* Return:
+*  cy_rslt_t: APP_RSLT_ERR_NOT_READY if the channel is busy
+*
+*******************************************************************************/
+cy_rslt_t uart_tx_send_direct(const uint8_t *data, uint32_t length,
+                              uint32_t *transfer)
+{
+    if ((tx_queue->length > 0u) || transfer_active(tx_channel))
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    start_transfer(tx_channel, data, length);
+    *transfer = tx_transfers;
+
+    TRNG_STATS_ADD(tx_bytes, length);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_is_sent
+********************************************************************************
+* Summary:
+* This function returns whether a transfer started by uart_tx_send_direct()
+* has completed.
+*
+* Parameters:
+*  transfer: Transfer identifier
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool uart_tx_is_sent(uint32_t transfer)
+{
+    uint32_t channel;
+
+    for (channel = 0; channel < (uint32_t)UART_TX_CHANNEL_COUNT; channel++)
+    {
+        if (tx_queues[channel].transfer == transfer)
+        {
+            return !transfer_active((uart_tx_channel_t)channel);
+        }
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_wait
+********************************************************************************
+* Summary:
+* This function waits until the transfer in progress on the current channel
+* has finished. It must be called before writing to the UART without the
+* transmit buffers.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_wait(void)
+{
+    wait_channel(tx_channel);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_busy
+********************************************************************************
+* Summary:
+* This function returns whether a transfer is in progress or output is queued
+* on any channel.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool uart_tx_busy(void)
+{
+    uint32_t channel;
+    bool busy = false;
+
+    for (channel = 0; channel < (uint32_t)UART_TX_CHANNEL_COUNT; channel++)
+    {
+        busy = busy || (tx_queues[channel].length > 0u) ||
+               transfer_active((uart_tx_channel_t)channel);
+    }
+
+    return busy;
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_set_baud
+********************************************************************************
+* Summary:
+* This function sends all output queued for the UART, waits until the last
+* bit has left the UART and then changes the baud rate.
+*
+* Parameters:
+*  baud: New baud rate
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t uart_tx_set_baud(uint32_t baud)
+{
+    uint32_t actual_baud;
+
+    flush_channel(UART_TX_CHANNEL_UART);
+    wait_channel(UART_TX_CHANNEL_UART);
+
+    while (!Cy_SCB_UART_IsTxComplete(tx_uart_obj->base))
+    {
+        /* Wait for the shift register to empty */
+    }
+
+    return cyhal_uart_set_baud(tx_uart_obj, baud, &actual_baud);
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_set_channel
+********************************************************************************
+* Summary:
+* This function selects the channel of the following output. Each channel has
+* its own transmit buffers, so the switch neither waits for the transfer on
+* the previous channel nor sends its queued output; uart_tx_scrub() sends that
+* once the previous channel is idle.
+*
+* Parameters:
+*  channel: Channel for the following output
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_set_channel(uart_tx_channel_t channel)
+{
+    if (channel < UART_TX_CHANNEL_COUNT)
+    {
+        tx_channel = channel;
+        tx_queue = &tx_queues[channel];
+    }
+}
+
+/*******************************************************************************
+* Function Name: uart_tx_get_channel
+********************************************************************************
+* Summary:
+* This function returns the channel the output is sent on.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  uart_tx_channel_t
+*
+*******************************************************************************/
+uart_tx_channel_t uart_tx_get_channel(void)
+{
+    return tx_channel;
+}
+
+/*******************************************************************************
+* Function Name: flush_channel
+********************************************************************************
+* Summary:
+* This function starts sending the active buffer of a channel and switches
+* the channel to its other buffer. It waits only if the previous transfer on
+* the channel has not finished yet.
+*
+* Parameters:
+*  channel: Channel to flush
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void flush_channel(uart_tx_channel_t channel)
+{
+    tx_queue_t *queue = &tx_queues[channel];
+
+    if (queue->length > 0u)
+    {
+        wait_channel(channel);
+
+        start_transfer(channel, queue->buffers[queue->active], queue->length);
+
+        queue->secret_length[queue->active] = queue->active_secret ?
+                                              queue->length : 0u;
+        queue->active_secret = false;
+
+        /* The next buffer has been sent, wipe it before it is filled again */
+        queue->active = (queue->active + 1u) % UART_TX_BUFFER_COUNT;
+        queue->length = 0;
+        scrub_buffer(queue, queue->active);
+    }
+}
+
+/*******************************************************************************
+* Function Name: wait_channel
+********************************************************************************
+* Summary:
+* This function waits until the transfer in progress on a channel has
+* finished.
+*
+* Parameters:
+*  channel: Channel to wait for
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void wait_channel(uart_tx_channel_t channel)
+{
+    TRNG_STATS_TIMER_START(wait_start);
+
+    while (transfer_active(channel))
+    {
+        /* Wait for the transfer to complete */
+    }
+
+    TRNG_STATS_TIMER_STOP(tx_wait_cycles, wait_start);
+}
+
+/*******************************************************************************
+* Function Name: start_transfer
+********************************************************************************
+* Summary:
+* This function starts an asynchronous transfer on a channel and records its
+* identifier.
+*
+* Parameters:
+*  channel: Channel to send on
+*  data: Data to send, unchanged until the transfer has completed
+*  length: Number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void start_transfer(uart_tx_channel_t channel, const uint8_t *data,
+                           uint32_t length)
+{
+    tx_transfers++;
+    tx_queues[channel].transfer = tx_transfers;
+
+#if defined(USB_CDC_ENABLE)
+    if (channel == UART_TX_CHANNEL_USB)
+    {
+        (void)usb_cdc_write(data, length);
+        return;
+    }
+#endif
+
+    (void)cyhal_uart_write_async(tx_uart_obj, (void *)data, length);
+}
+
+/*******************************************************************************
+* Function Name: transfer_active
+********************************************************************************
+* Summary:
+* This function returns whether a transfer is in progress on a channel.
+*
+* Parameters:
+*  channel: Channel to check
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+static bool transfer_active(uart_tx_channel_t channel)
+{
+#if defined(USB_CDC_ENABLE)
+    if (channel == UART_TX_CHANNEL_USB)
+    {
+        return usb_cdc_is_tx_active();
+    }
+#else
+    CY_UNUSED_PARAMETER(channel);
+#endif
+
+    return cyhal_uart_is_tx_active(tx_uart_obj);
+}
+
+/*******************************************************************************
+* Function Name: scrub_buffer
+********************************************************************************
+* Summary:
+* This function wipes the secret output of a transmit buffer whose transfer
+* has completed.
+*
+* Parameters:
+*  queue: Queue of the channel
+*  buffer: Index of the buffer
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void scrub_buffer(tx_queue_t *queue, uint32_t buffer)
+{
+    if (queue->secret_length[buffer] > 0u)
+    {
+        zeroize(queue->buffers[buffer], queue->secret_length[buffer]);
+        queue->secret_length[buffer] = 0;
+    }
+}
+
+/*******************************************************************************
+* Function Name: put_char
+********************************************************************************
+* Summary:
+* This function queues one character.
+*
+* Parameters:
+*  value: Character to queue
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void put_char(char value)
+{
+    *uart_tx_reserve(1u) = (uint8_t)value;
+    uart_tx_commit(1u);
+}
+
+/*******************************************************************************
+* Function Name: format_digits
+********************************************************************************
+* Summary:
+* This function writes the digits of a number into tx_digits, least
+* significant digit first. Values that fit into 32 bits are converted with
+* 32-bit divisions.
+*
+* Parameters:
+*  value: Number to convert
+*  base: 10 or 16
+*  upper: Use upper case hexadecimal digits
+*
+* Return:
+*  uint32_t: Number of digits
+*
+*******************************************************************************/
+static uint32_t format_digits(uint64_t value, uint32_t base, bool upper)
+{
+    const char *symbols = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    uint32_t count = 0;
+    uint32_t low;
+
+    while (value > UINT32_MAX)
+    {
+        tx_digits[count++] = symbols[value % base];
+        value /= base;
+    }
+
+    low = (uint32_t)value;
+
+    do
+    {
+        tx_digits[count++] = symbols[low % base];
+        low /= base;
+    } while (low != 0u);
+
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: put_field
+********************************************************************************
+* Summary:
+* This function queues one converted field, padded to the field width.
+*
+* Parameters:
+*  text: Characters of the field
+*  length: Number of characters
+*  reversed: The characters are stored last character first
+*  sign: Sign to put in front of the characters, or '\0'
+*  width: Minimum field width
+*  left: Pad on the right instead of the left
+*  pad: Padding character on the left, ' ' or '0'
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void put_field(const char *text, uint32_t length, bool reversed,
+                      char sign, uint32_t width, bool left, char pad)
+{
+    uint32_t used = length + ((sign != '\0') ? 1u : 0u);
+    uint32_t index;
+
+    /* Zeros go between the sign and the digits */
+    if ((sign != '\0') && (pad == '0'))
+    {
+        put_char(sign);
+    }
+
+    for (; !left && (used < width); used++)
+    {
+        put_char(pad);
+    }
+
+    if ((sign != '\0') && (pad != '0'))
+    {
+        put_char(sign);
+    }
+
+    for (index = 0; index < length; index++)
+    {
+        put_char(reversed ? text[length - 1u - index] : text[index]);
+    }
+
+    for (; left && (used < width); used++)
+    {
+        put_char(' ');
+    }
+}
+
+/* [] END OF FILE */
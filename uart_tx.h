@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name:   uart_tx.h
+*
+* Description: This file contains the interface of the asynchronous UART output
+* queue for the HAL: MCU Cryptography: True Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef UART_TX_H
+#define UART_TX_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Size of each of the two transmit buffers of a channel */
+#define UART_TX_BUFFER_SIZE             (512u)
+
+/* Digits of the longest number uart_tx_printf() formats (2^64 - 1) */
+#define UART_TX_DIGITS_SIZE             (20u)
+
+/*******************************************************************************
+* Data Types
+********************************************************************************/
+/* Channels the output can be sent on, each with its own transmit buffers */
+typedef enum
+{
+    UART_TX_CHANNEL_UART,   /* Debug UART */
+#if defined(USB_CDC_ENABLE)
+    UART_TX_CHANNEL_USB,    /* Virtual COM port of the USB CDC device */
+#endif
+    UART_TX_CHANNEL_COUNT
+} uart_tx_channel_t;
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t uart_tx_init(cyhal_uart_t *uart_obj);
+uint8_t *uart_tx_reserve(uint32_t length);
+void uart_tx_commit(uint32_t length);
+void uart_tx_puts(const char *text);
+void uart_tx_printf(const char *format, ...);
+void uart_tx_set_secret(bool secret);
+void uart_tx_scrub(void);
+bool uart_tx_secret_pending(void);
+void uart_tx_flush(void);
+cy_rslt_t uart_tx_send_direct(const uint8_t *data, uint32_t length,
+                              uint32_t *transfer);
+bool uart_tx_is_sent(uint32_t transfer);
+void uart_tx_wait(void);
+bool uart_tx_busy(void);
+cy_rslt_t uart_tx_set_baud(uint32_t baud);
+void uart_tx_set_channel(uart_tx_channel_t channel);
+uart_tx_channel_t uart_tx_get_channel(void);
+
+#endif /* UART_TX_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,437 @@
+/******************************************************************************
+* File Name:   usb_cdc.c
+*
+* Description: This file contains the USB CDC channel. The USBFS block of the
+* device enumerates as a virtual COM port, so requests are served over the USB
+* full-speed interface next to the debug UART. Transmission is driven by the
+* USB interrupts one packet at a time straight from the transmit buffer, and
+* received packets are moved into a ring buffer by the console.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#if defined(USB_CDC_ENABLE)
+
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "cycfg_usbdev.h"
+#include "cy_usb_dev.h"
+#include "cy_usb_dev_cdc.h"
+#include "usb_cdc.h"
+#include "app_result.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+#define USB_CDC_INDEX_MASK              (USB_CDC_RX_BUFFER_SIZE - 1u)
+
+/* DTR bit of the CDC SET_CONTROL_LINE_STATE request. A terminal program sets
+   it while the port is open */
+#define USB_CDC_LINE_CONTROL_DTR        (0x01u)
+
+/* Interrupt priorities of the USBFS block */
+#define USB_CDC_HI_INTR_PRIORITY        (5u)
+#define USB_CDC_MED_INTR_PRIORITY       (6u)
+#define USB_CDC_LO_INTR_PRIORITY        (7u)
+
+#if ((USB_CDC_RX_BUFFER_SIZE & USB_CDC_INDEX_MASK) != 0u) || \
+    (USB_CDC_RX_BUFFER_SIZE < (2u * USB_CDC_PACKET_SIZE))
+#error "USB_CDC_RX_BUFFER_SIZE must be a power of two of at least two packets"
+#endif
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+static void usb_high_isr(void);
+static void usb_medium_isr(void);
+static void usb_low_isr(void);
+static void send_next_packet(void);
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Contexts of the USBFS driver, the device and the CDC class */
+static cy_stc_usbfs_dev_drv_context_t usb_drv_context;
+static cy_stc_usb_dev_context_t usb_dev_context;
+static cy_stc_usb_dev_cdc_context_t usb_cdc_context;
+
+/* Received characters. Both indices are written by the console only */
+static uint8_t rx_buffer[USB_CDC_RX_BUFFER_SIZE];
+static uint32_t rx_head = 0;
+static uint32_t rx_tail = 0;
+
+/* Rest of the transfer in progress, sent by the USB interrupts */
+static const uint8_t *volatile tx_data = NULL;
+static volatile uint32_t tx_remaining = 0;
+
+/*******************************************************************************
+* Function Name: usb_cdc_init
+********************************************************************************
+* Summary:
+* This function initializes the USBFS block with the CDC device of the USB
+* Configurator design and connects it to the bus. The call does not wait for
+* the enumeration, so the debug UART is served while no USB host is attached.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  cy_rslt_t
+*
+*******************************************************************************/
+cy_rslt_t usb_cdc_init(void)
+{
+    const cy_stc_sysint_t usb_high_intr_cfg =
+    {
+        .intrSrc = (IRQn_Type)usb_interrupt_hi_IRQn,
+        .intrPriority = USB_CDC_HI_INTR_PRIORITY
+    };
+    const cy_stc_sysint_t usb_medium_intr_cfg =
+    {
+        .intrSrc = (IRQn_Type)usb_interrupt_med_IRQn,
+        .intrPriority = USB_CDC_MED_INTR_PRIORITY
+    };
+    const cy_stc_sysint_t usb_low_intr_cfg =
+    {
+        .intrSrc = (IRQn_Type)usb_interrupt_lo_IRQn,
+        .intrPriority = USB_CDC_LO_INTR_PRIORITY
+    };
+
+    if ((Cy_USB_Dev_Init(CYBSP_USBDEV_HW, &CYBSP_USBDEV_config,
+                         &usb_drv_context, &usb_devices[0], &usb_devConfig,
+                         &usb_dev_context) != CY_USB_DEV_SUCCESS) ||
+        (Cy_USB_Dev_CDC_Init(&usb_cdcConfig, &usb_cdc_context,
+                             &usb_dev_context) != CY_USB_DEV_SUCCESS))
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    if ((Cy_SysInt_Init(&usb_high_intr_cfg, usb_high_isr) !=
+         CY_SYSINT_SUCCESS) ||
+        (Cy_SysInt_Init(&usb_medium_intr_cfg, usb_medium_isr) !=
+         CY_SYSINT_SUCCESS) ||
+        (Cy_SysInt_Init(&usb_low_intr_cfg, usb_low_isr) != CY_SYSINT_SUCCESS))
+    {
+        return APP_RSLT_ERR_NOT_READY;
+    }
+
+    NVIC_EnableIRQ(usb_high_intr_cfg.intrSrc);
+    NVIC_EnableIRQ(usb_medium_intr_cfg.intrSrc);
+    NVIC_EnableIRQ(usb_low_intr_cfg.intrSrc);
+
+    (void)Cy_USB_Dev_Connect(false, CY_USB_DEV_WAIT_FOREVER, &usb_dev_context);
+
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: usb_cdc_process
+********************************************************************************
+* Summary:
+* This function moves a received packet from the CDC OUT endpoint into the
+* receive buffer if the buffer can take a full packet. Otherwise the packet
+* stays in the endpoint, and the host is held off until the console has read
+* the buffered characters. It is called by the console before reading.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void usb_cdc_process(void)
+{
+    uint8_t packet[USB_CDC_PACKET_SIZE];
+    uint32_t count;
+    uint32_t index;
+
+    if (((USB_CDC_RX_BUFFER_SIZE - (rx_head - rx_tail)) >=
+         USB_CDC_PACKET_SIZE) &&
+        Cy_USB_Dev_CDC_IsDataReady(USB_CDC_PORT, &usb_cdc_context))
+    {
+        count = Cy_USB_Dev_CDC_GetAll(USB_CDC_PORT, packet,
+                                      USB_CDC_PACKET_SIZE, &usb_cdc_context);
+
+        for (index = 0; index < count; index++)
+        {
+            rx_buffer[rx_head & USB_CDC_INDEX_MASK] = packet[index];
+            rx_head++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: usb_cdc_getc
+********************************************************************************
+* Summary:
+* This function takes one received character from the receive buffer.
+*
+* Parameters:
+*  value: Location to store the character
+*
+* Return:
+*  bool: false if no character is buffered
+*
+*******************************************************************************/
+bool usb_cdc_getc(uint8_t *value)
+{
+    if (rx_head == rx_tail)
+    {
+        return false;
+    }
+
+    *value = rx_buffer[rx_tail & USB_CDC_INDEX_MASK];
+    rx_tail++;
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: usb_cdc_rx_pending
+********************************************************************************
+* Summary:
+* This function returns whether received characters are buffered or waiting
+* in the CDC OUT endpoint.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool usb_cdc_rx_pending(void)
+{
+    return ((rx_head != rx_tail) ||
+            Cy_USB_Dev_CDC_IsDataReady(USB_CDC_PORT, &usb_cdc_context));
+}
+
+/*******************************************************************************
+* Function Name: usb_cdc_write
+********************************************************************************
+* Summary:
+* This function starts sending data from the caller's memory. The first
+* packet is loaded into the CDC IN endpoint here and each further packet by
+* the interrupt of the previous one. The endpoints must use the CPU endpoint
+* management mode, so a packet is copied into the USBFS block when it is
+* loaded. Without an open terminal on the host, the data is dropped, so the
+* debug UART is never held up by an idle USB port. Only one transfer can be
+* in progress; a write while usb_cdc_is_tx_active() returns true is refused.
+*
+* Parameters:
+*  data: Data to send, unchanged until usb_cdc_is_tx_active() returns false
+*  length: Number of bytes
+*
+* Return:
+*  cy_rslt_t: APP_RSLT_ERR_NOT_READY if a transfer is still in progress
+*
+*******************************************************************************/
+cy_rslt_t usb_cdc_write(const uint8_t *data, uint32_t length)
+{
+    uint32_t saved_intr_status;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    saved_intr_status = cyhal_system_critical_section_enter();
+    if (tx_remaining > 0u)
+    {
+        /* The caller must wait for the previous transfer */
+        CY_ASSERT(0);
+        result = APP_RSLT_ERR_NOT_READY;
+    }
+    else
+    {
+        tx_data = data;
+        tx_remaining = length;
+        send_next_packet();
+    }
+    cyhal_system_critical_section_exit(saved_intr_status);
+
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: usb_cdc_is_tx_active
+********************************************************************************
+* Summary:
+* This function returns whether a transfer started by usb_cdc_write() still
+* has data to load into the IN endpoint.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool usb_cdc_is_tx_active(void)
+{
+    return (tx_remaining > 0u);
+}
+
+/*******************************************************************************
+* Function Name: usb_cdc_is_connected
+********************************************************************************
+* Summary:
+* This function returns whether the device is configured by a host and a
+* terminal has opened the virtual COM port.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  bool
+*
+*******************************************************************************/
+bool usb_cdc_is_connected(void)
+{
+    return ((Cy_USB_Dev_GetConfiguration(&usb_dev_context) != 0u) &&
+            ((Cy_USB_Dev_CDC_GetLineControl(USB_CDC_PORT, &usb_cdc_context) &
+              USB_CDC_LINE_CONTROL_DTR) != 0u));
+}
+
+/*******************************************************************************
+* Function Name: send_next_packet
+********************************************************************************
+* Summary:
+* This function loads the next packet of the transfer in progress into the IN
+* endpoint once the host has taken the previous one. The rest of the transfer
+* is dropped when the terminal closes. Called from the USB interrupts and,
+* with interrupts disabled, from usb_cdc_write().
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void send_next_packet(void)
+{
+    uint32_t chunk;
+
+    if (tx_remaining == 0u)
+    {
+        return;
+    }
+
+    if (!usb_cdc_is_connected())
+    {
+        tx_remaining = 0;
+    }
+    else if (Cy_USB_Dev_CDC_IsReady(USB_CDC_PORT, &usb_cdc_context))
+    {
+        chunk = (tx_remaining > USB_CDC_PACKET_SIZE) ? USB_CDC_PACKET_SIZE :
+                tx_remaining;
+
+        if (Cy_USB_Dev_CDC_PutData(USB_CDC_PORT, tx_data, chunk,
+                                   &usb_cdc_context) == CY_USB_DEV_SUCCESS)
+        {
+            tx_data += chunk;
+            tx_remaining -= chunk;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: usb_high_isr
+********************************************************************************
+* Summary:
+* High priority USBFS interrupt handler. Serves the USBFS block and continues
+* the transfer in progress.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void usb_high_isr(void)
+{
+    Cy_USBFS_Dev_Drv_Interrupt(CYBSP_USBDEV_HW,
+                               Cy_USBFS_Dev_Drv_GetInterruptCauseHi(
+                               CYBSP_USBDEV_HW), &usb_drv_context);
+    send_next_packet();
+}
+
+/*******************************************************************************
+* Function Name: usb_medium_isr
+********************************************************************************
+* Summary:
+* Medium priority USBFS interrupt handler. Serves the USBFS block and
+* continues the transfer in progress.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void usb_medium_isr(void)
+{
+    Cy_USBFS_Dev_Drv_Interrupt(CYBSP_USBDEV_HW,
+                               Cy_USBFS_Dev_Drv_GetInterruptCauseMed(
+                               CYBSP_USBDEV_HW), &usb_drv_context);
+    send_next_packet();
+}
+
+/*******************************************************************************
+* Function Name: usb_low_isr
+********************************************************************************
+* Summary:
+* Low priority USBFS interrupt handler. Serves the USBFS block and continues
+* the transfer in progress.
+*
+* Parameters:
+*  void
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void usb_low_isr(void)
+{
+    Cy_USBFS_Dev_Drv_Interrupt(CYBSP_USBDEV_HW,
+                               Cy_USBFS_Dev_Drv_GetInterruptCauseLo(
+                               CYBSP_USBDEV_HW), &usb_drv_context);
+    send_next_packet();
+}
+
+#endif /* USB_CDC_ENABLE */
+
+/* [] END OF FILE */
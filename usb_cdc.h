@@ -0,0 +1,74 @@
+/******************************************************************************
+* File Name:   usb_cdc.h
+*
+* Description: This file contains the interface of the USB CDC channel of the
+* HAL: MCU Cryptography: True Random Number Generation Example.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef USB_CDC_H
+#define USB_CDC_H
+
+#include "cyhal.h"
+
+/*******************************************************************************
+* Macros
+********************************************************************************/
+/* Number of received characters buffered between the CDC OUT endpoint and
+   the console. Must be a power of two of at least two packets */
+#define USB_CDC_RX_BUFFER_SIZE          (256u)
+
+/* Maximum packet size of the CDC data endpoints (full speed) */
+#define USB_CDC_PACKET_SIZE             (64u)
+
+/* CDC interface of the USB Configurator design */
+#define USB_CDC_PORT                    (0u)
+
+/*******************************************************************************
+* Function Prototypes
+********************************************************************************/
+cy_rslt_t usb_cdc_init(void);
+void usb_cdc_process(void);
+bool usb_cdc_getc(uint8_t *value);
+bool usb_cdc_rx_pending(void);
+cy_rslt_t usb_cdc_write(const uint8_t *data, uint32_t length);
+bool usb_cdc_is_tx_active(void);
+bool usb_cdc_is_connected(void);
+
+#endif /* USB_CDC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,75 @@
+/******************************************************************************
+* File Name:   zeroize.c
+*
+* Description: This file contains the wipe of buffers that held secret data,
+* such as passwords, key material and random output. Unlike a plain memset(),
+* the wipe cannot be removed by the compiler when the buffer is not read
+* afterwards.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "zeroize.h"
+
+/*******************************************************************************
+* Global Variables
+********************************************************************************/
+/* Called through a volatile pointer, so the compiler cannot tell that it is
+   memset() and drop the call as a dead store */
+static void *(* const volatile zeroize_memset)(void *, int, size_t) = memset;
+
+/*******************************************************************************
+* Function Name: zeroize
+********************************************************************************
+* Summary:
+* This function overwrites a buffer with zeros. It runs at the speed of
+* memset(), so wiping adds no copy pass to the output paths.
+*
+* Parameters:
+*  buffer: Buffer to wipe
+*  size: Number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void zeroize(void *buffer, size_t size)
+{
+    (void)zeroize_memset(buffer, 0, size);
+}
+
+/* [] END OF FILE */